@@ -26,6 +26,7 @@
 #include "el_algorithm_base.h"
 
 #include <cstdint>
+#include <cstring>
 
 #include "core/el_debug.h"
 #include "core/el_types.h"
@@ -37,6 +38,10 @@ Algorithm::Algorithm(EngineType* engine, const InfoType& info)
     : __p_engine(engine),
       __p_input(nullptr),
       __algorithm_info(info),
+      __pipelined(false),
+      __in_flight(false),
+      __staged_input{0, nullptr, 0},
+      __run_start_time(0),
       __preprocess_time(0),
       __run_time(0),
       __postprocess_time(0) {
@@ -47,6 +52,10 @@ Algorithm::Algorithm(EngineType* engine, const InfoType& info)
 }
 
 Algorithm::~Algorithm() {
+    // derived algorithms may drop the engine before getting here, a run still in flight only reads the engine's
+    // own tensors and is waited for by whoever uses the engine next
+    release_staging();
+
     __p_engine = nullptr;
     __p_input  = nullptr;
 
@@ -64,6 +73,13 @@ el_err_code_t Algorithm::underlying_run(void* input) {
 
     __p_input = input;
 
+    if (__pipelined) {
+        return pipelined_run();
+    }
+    // a pipelined algorithm gone before its last run finished leaves the run to the engine, the input tensor must
+    // not be written while it is still being read
+    __p_engine->wait();
+
     // preprocess
     start_time        = el_get_time_ms();
     ret               = preprocess();
@@ -99,6 +115,130 @@ el_err_code_t Algorithm::underlying_run(void* input) {
     return ret;
 }
 
+// preprocesses input N into the staged input while the engine runs N - 1, then collects the outputs of N - 1, hands
+// input N to the engine and postprocesses N - 1 while N runs
+el_err_code_t Algorithm::pipelined_run() {
+    el_err_code_t ret{EL_OK};
+    uint32_t      start_time{0};
+    uint32_t      end_time{0};
+
+    // preprocess
+    start_time        = el_get_time_ms();
+    ret               = preprocess();
+    end_time          = el_get_time_ms();
+    __preprocess_time = end_time - start_time;
+
+    EL_ON_ALGO_PREPROCESS_DONE;
+
+    if (ret != EL_OK) {
+        return ret;
+    }
+
+    // run, the time reported is from handing the input to the engine until its outputs are collected
+    bool has_previous = __in_flight;
+    __in_flight       = false;
+    ret               = __p_engine->wait();
+    if (has_previous) {
+        __run_time = el_get_time_ms() - __run_start_time;
+
+        EL_ON_ALGO_RUN_DONE;
+
+        if (ret != EL_OK) {
+            return ret;
+        }
+        for (auto& output : __staged_outputs)
+            std::memcpy(output.data, __p_engine->get_output(output.index), output.size);
+    }
+
+    ret = __p_engine->set_input(0, __staged_input.data, __staged_input.size);
+    if (ret != EL_OK) {
+        return ret;
+    }
+    __run_start_time = el_get_time_ms();
+    ret              = __p_engine->run_async();
+    if (ret != EL_OK) {
+        return ret;
+    }
+    __in_flight = true;
+
+    if (!has_previous) {
+        return EL_OK;
+    }
+
+    // postprocess
+    start_time         = el_get_time_ms();
+    ret                = postprocess();
+    end_time           = el_get_time_ms();
+    __postprocess_time = end_time - start_time;
+
+    EL_ON_ALGO_POSTPROCESS_DONE;
+
+    return ret;
+}
+
+el_err_code_t Algorithm::set_pipelined(bool enable) {
+    EL_ASSERT(__p_engine != nullptr);
+
+    if (enable == __pipelined) {
+        return EL_OK;
+    }
+    if (!enable) {
+        release_staging();
+        return EL_OK;
+    }
+
+    // sized in bytes, the engine copies whole tensors whatever their element type
+    __staged_input.size = __p_engine->get_input_size(0);
+    __staged_input.data = __staged_input.size ? el_malloc(__staged_input.size) : nullptr;
+    if (__staged_input.data == nullptr) {
+        release_staging();
+        return EL_ENOMEM;
+    }
+    for (size_t i = 0; __p_engine->get_output(i) != nullptr; ++i) {
+        el_tensor_t output{i, nullptr, __p_engine->get_output_size(i)};
+        output.data = output.size ? el_malloc(output.size) : nullptr;
+        if (output.data == nullptr) {
+            release_staging();
+            return EL_ENOMEM;
+        }
+        __staged_outputs.push_back(output);
+    }
+
+    std::memset(__staged_input.data, 0, __staged_input.size);
+    __p_engine->wait();
+    if (__p_engine->set_input(0, __staged_input.data, __staged_input.size) != EL_OK) {
+        release_staging();
+        return EL_ENOTSUP;
+    }
+
+    __pipelined = true;
+    return EL_OK;
+}
+
+bool Algorithm::is_pipelined() const { return __pipelined; }
+
+void Algorithm::release_staging() {
+    // the outputs of a run still in flight are not wanted anymore
+    if (__in_flight && __p_engine) __p_engine->wait();
+    __in_flight = false;
+
+    if (__staged_input.data) el_free(__staged_input.data);
+    __staged_input = el_tensor_t{0, nullptr, 0};
+    for (auto& output : __staged_outputs) el_free(output.data);
+    __staged_outputs.clear();
+
+    __pipelined = false;
+}
+
+void* Algorithm::get_input_data() { return __pipelined ? __staged_input.data : __p_engine->get_input(0); }
+
+void* Algorithm::get_output_data(size_t index) {
+    if (!__pipelined) {
+        return __p_engine->get_output(index);
+    }
+    return index < __staged_outputs.size() ? __staged_outputs[index].data : nullptr;
+}
+
 Algorithm::InfoType Algorithm::get_algorithm_info() const { return __algorithm_info; };
 
 uint32_t Algorithm::get_preprocess_time() const { return __preprocess_time; }
@@ -27,6 +27,7 @@
 #define _EL_ALGORITHM_BASE_H_
 
 #include <cstdint>
+#include <vector>
 
 #include "core/el_types.h"
 #include "core/engine/el_engine_base.h"
@@ -84,9 +85,18 @@ class Algorithm {
     uint32_t get_run_time() const;
     uint32_t get_postprocess_time() const;
 
+    // the next input is preprocessed while the engine is still running the previous one, so results lag one input
+    // behind and the first run after enabling yields none, the tensors are staged in buffers of their own meanwhile
+    el_err_code_t set_pipelined(bool enable);
+    bool          is_pipelined() const;
+
    protected:
     el_err_code_t underlying_run(void* input);
 
+    // where preprocess() writes the input and postprocess() reads the outputs, the tensors unless pipelined
+    void* get_input_data();
+    void* get_output_data(size_t index);
+
     virtual el_err_code_t preprocess()  = 0;
     virtual el_err_code_t postprocess() = 0;
 
@@ -101,8 +111,17 @@ class Algorithm {
     el_quant_param_t __output_quant;
 
    private:
+    el_err_code_t pipelined_run();
+    void          release_staging();
+
     InfoType __algorithm_info;
 
+    bool                     __pipelined;
+    bool                     __in_flight;
+    el_tensor_t              __staged_input;
+    std::vector<el_tensor_t> __staged_outputs;
+    uint32_t                 __run_start_time;
+
     uint32_t __preprocess_time;   // ms
     uint32_t __run_time;          // ms
     uint32_t __postprocess_time;  // ms
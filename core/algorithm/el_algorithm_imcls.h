@@ -31,6 +31,7 @@
 #include <forward_list>
 
 #include "core/el_types.h"
+#include "core/utils/el_cv.h"
 #include "el_algorithm_base.h"
 
 namespace edgelab {
@@ -80,7 +81,9 @@ class AlgorithmIMCLS final : public Algorithm {
     el_err_code_t postprocess() override;
 
    private:
-    ImageType _input_img;
+    ImageType      _input_img;
+    el_img_lut_t   _input_lut;
+    ImgConvertPlan _input_plan;
 
     std::atomic<ScoreType> _score_threshold;
 
@@ -76,6 +76,7 @@ inline void AlgorithmPFLD::init() {
       static_cast<decltype(ImageType::size)>(_input_img.width * _input_img.height * this->__input_shape.dims[3]);
     _input_img.format = EL_PIXEL_FORMAT_UNKNOWN;
     _input_img.rotate = EL_PIXEL_ROTATE_0;
+    _input_img.pitch  = 0;
 
     if (this->__input_shape.dims[3] == 3) {
         _input_img.format = EL_PIXEL_FORMAT_RGB888;
@@ -85,6 +86,8 @@ inline void AlgorithmPFLD::init() {
 
     EL_ASSERT(_input_img.format != EL_PIXEL_FORMAT_UNKNOWN);
     EL_ASSERT(_input_img.rotate != EL_PIXEL_ROTATE_UNKNOWN);
+
+    el_img_lut_from_quant(&_input_lut, &this->__input_quant);
 }
 
 el_err_code_t AlgorithmPFLD::run(ImageType* input) {
@@ -97,23 +100,23 @@ el_err_code_t AlgorithmPFLD::run(ImageType* input) {
 
 el_err_code_t AlgorithmPFLD::preprocess() {
     auto* i_img{static_cast<ImageType*>(this->__p_input)};
+    _input_img.data = static_cast<decltype(ImageType::data)>(this->get_input_data());
 
-    // convert image
-    el_img_convert(i_img, &_input_img);
-
-    auto size{_input_img.size};
-    for (decltype(ImageType::size) i{0}; i < size; ++i) {
-        _input_img.data[i] -= 128;
+    // convert image, the input quantization is fused into the conversion, the plan is rebuilt on geometry changes
+    if (!_input_plan.is_built_for(i_img, &_input_img)) [[unlikely]] {
+        auto ret{_input_plan.build(i_img, &_input_img, &_input_lut)};
+        if (ret != EL_OK) [[unlikely]]
+            return ret;
     }
 
-    return EL_OK;
+    return _input_plan.execute(i_img, &_input_img);
 }
 
 el_err_code_t AlgorithmPFLD::postprocess() {
     _results.clear();
 
     // get output
-    auto*   data{static_cast<int8_t*>(this->__p_engine->get_output(0))};
+    auto*   data{static_cast<int8_t*>(this->get_output_data(0))};
     float   scale{this->__output_quant.scale};
     bool    rescale{scale < 0.1f ? true : false};
     int32_t zero_point{this->__output_quant.zero_point};
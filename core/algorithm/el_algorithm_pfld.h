@@ -30,6 +30,7 @@
 #include <forward_list>
 
 #include "core/el_types.h"
+#include "core/utils/el_cv.h"
 #include "el_algorithm_base.h"
 
 namespace edgelab {
@@ -74,9 +75,11 @@ class AlgorithmPFLD final : public Algorithm {
     el_err_code_t postprocess() override;
 
    private:
-    ImageType _input_img;
-    float     _w_scale;
-    float     _h_scale;
+    ImageType      _input_img;
+    el_img_lut_t   _input_lut;
+    ImgConvertPlan _input_plan;
+    float          _w_scale;
+    float          _h_scale;
 
     std::forward_list<PointType> _results;
 };
@@ -38,8 +38,7 @@ AlgorithmYOLO::InfoType AlgorithmYOLO::algorithm_info{types::el_algorithm_yolo_c
 
 AlgorithmYOLO::AlgorithmYOLO(EngineType* engine, ScoreType score_threshold, IoUType iou_threshold)
     : Algorithm(engine, AlgorithmYOLO::algorithm_info),
-      _w_scale(1.f),
-      _h_scale(1.f),
+      _input_map{},
       _score_threshold(score_threshold),
       _iou_threshold(iou_threshold) {
     init();
@@ -47,8 +46,7 @@ AlgorithmYOLO::AlgorithmYOLO(EngineType* engine, ScoreType score_threshold, IoUT
 
 AlgorithmYOLO::AlgorithmYOLO(EngineType* engine, const ConfigType& config)
     : Algorithm(engine, config.info),
-      _w_scale(1.f),
-      _h_scale(1.f),
+      _input_map{},
       _score_threshold(config.score_threshold),
       _iou_threshold(config.iou_threshold) {
     init();
@@ -101,6 +99,7 @@ inline void AlgorithmYOLO::init() {
       static_cast<decltype(ImageType::size)>(_input_img.width * _input_img.height * this->__input_shape.dims[3]);
     _input_img.format = EL_PIXEL_FORMAT_UNKNOWN;
     _input_img.rotate = EL_PIXEL_ROTATE_0;
+    _input_img.pitch  = 0;
     if (this->__input_shape.dims[3] == 3) {
         _input_img.format = EL_PIXEL_FORMAT_RGB888;
     } else if (this->__input_shape.dims[3] == 1) {
@@ -108,11 +107,13 @@ inline void AlgorithmYOLO::init() {
     }
     EL_ASSERT(_input_img.format != EL_PIXEL_FORMAT_UNKNOWN);
     EL_ASSERT(_input_img.rotate != EL_PIXEL_ROTATE_UNKNOWN);
+
+    el_img_lut_from_quant(&_input_lut, &this->__input_quant);
 }
 
 el_err_code_t AlgorithmYOLO::run(ImageType* input) {
-    _w_scale = static_cast<float>(input->width) / static_cast<float>(_input_img.width);
-    _h_scale = static_cast<float>(input->height) / static_cast<float>(_input_img.height);
+    // the frame is letterboxed into the model input, boxes are mapped back through the same fit
+    el_img_fit_map(input, &_input_img, EL_PIXEL_FIT_LETTERBOX, &_input_map);
 
     // TODO: image type conversion before underlying_run, because underlying_run doing a type erasure
     return underlying_run(input);
@@ -120,23 +121,23 @@ el_err_code_t AlgorithmYOLO::run(ImageType* input) {
 
 el_err_code_t AlgorithmYOLO::preprocess() {
     auto* i_img{static_cast<ImageType*>(this->__p_input)};
+    _input_img.data = static_cast<decltype(ImageType::data)>(this->get_input_data());
 
-    // convert image
-    el_img_convert(i_img, &_input_img);
-
-    auto size{_input_img.size};
-    for (decltype(ImageType::size) i{0}; i < size; ++i) {
-        _input_img.data[i] -= 128;
+    // convert image, the input quantization is fused into the conversion, the plan is rebuilt on geometry changes
+    if (!_input_plan.is_built_for(i_img, &_input_img)) [[unlikely]] {
+        auto ret{_input_plan.build(i_img, &_input_img, &_input_lut, EL_PIXEL_INTERP_NEAREST, EL_PIXEL_FIT_LETTERBOX)};
+        if (ret != EL_OK) [[unlikely]]
+            return ret;
     }
 
-    return EL_OK;
+    return _input_plan.execute(i_img, &_input_img);
 }
 
 el_err_code_t AlgorithmYOLO::postprocess() {
     _results.clear();
 
     // get output
-    auto* data{static_cast<int8_t*>(this->__p_engine->get_output(0))};
+    auto* data{static_cast<int8_t*>(this->get_output_data(0))};
 
     auto width{this->__input_shape.dims[1]};
     auto height{this->__input_shape.dims[2]};
@@ -190,10 +191,13 @@ el_err_code_t AlgorithmYOLO::postprocess() {
                 h = h * height;
             }
 
-            box.x = EL_CLIP(x, 0, width) * _w_scale;
-            box.y = EL_CLIP(y, 0, height) * _h_scale;
-            box.w = EL_CLIP(w, 0, width) * _w_scale;
-            box.h = EL_CLIP(h, 0, height) * _h_scale;
+            // the center is clipped to the letterboxed area before being mapped back to the frame
+            box.x = (EL_CLIP(x, _input_map.x_offset, _input_map.x_offset + _input_map.w) - _input_map.x_offset) *
+                    _input_map.x_scale;
+            box.y = (EL_CLIP(y, _input_map.y_offset, _input_map.y_offset + _input_map.h) - _input_map.y_offset) *
+                    _input_map.y_scale;
+            box.w = EL_CLIP(w, 0, _input_map.w) * _input_map.x_scale;
+            box.h = EL_CLIP(h, 0, _input_map.h) * _input_map.y_scale;
 
             _results.emplace_front(std::move(box));
         }
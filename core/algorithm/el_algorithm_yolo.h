@@ -31,6 +31,7 @@
 #include <forward_list>
 
 #include "core/el_types.h"
+#include "core/utils/el_cv.h"
 #include "el_algorithm_base.h"
 
 namespace edgelab {
@@ -94,9 +95,10 @@ class AlgorithmYOLO final : public Algorithm {
         INDEX_T = 5,
     };
 
-    ImageType _input_img;
-    float     _w_scale;
-    float     _h_scale;
+    ImageType      _input_img;
+    el_img_lut_t   _input_lut;
+    ImgConvertPlan _input_plan;
+    el_img_map_t   _input_map;
 
     std::atomic<ScoreType> _score_threshold;
     std::atomic<IoUType>   _iou_threshold;
@@ -45,8 +45,7 @@ AlgorithmYOLOPOSE::AlgorithmYOLOPOSE(EngineType* engine, ScoreType score_thresho
     : Algorithm(engine, AlgorithmYOLOPOSE::algorithm_info),
       _last_input_width(0),
       _last_input_height(0),
-      _w_scale(1.f),
-      _h_scale(1.f),
+      _input_map{.x_scale = 1.f, .y_scale = 1.f},
       _score_threshold(score_threshold),
       _iou_threshold(iou_threshold) {
     init();
@@ -56,8 +55,7 @@ AlgorithmYOLOPOSE::AlgorithmYOLOPOSE(EngineType* engine, const ConfigType& confi
     : Algorithm(engine, config.info),
       _last_input_width(0),
       _last_input_height(0),
-      _w_scale(1.f),
-      _h_scale(1.f),
+      _input_map{.x_scale = 1.f, .y_scale = 1.f},
       _score_threshold(config.score_threshold),
       _iou_threshold(config.iou_threshold) {
     init();
@@ -70,16 +68,16 @@ AlgorithmYOLOPOSE::~AlgorithmYOLOPOSE() {
 
 el_err_code_t AlgorithmYOLOPOSE::preprocess() {
     auto* i_img{static_cast<ImageType*>(this->__p_input)};
+    _input_img.data = static_cast<decltype(ImageType::data)>(this->get_input_data());
 
-    // convert image
-    el_img_convert(i_img, &_input_img);
-
-    auto size{_input_img.size};
-    for (decltype(ImageType::size) i{0}; i < size; ++i) {
-        _input_img.data[i] -= 128;
+    // convert image, the input quantization is fused into the conversion, the plan is rebuilt on geometry changes
+    if (!_input_plan.is_built_for(i_img, &_input_img)) [[unlikely]] {
+        auto ret{_input_plan.build(i_img, &_input_img, &_input_lut, EL_PIXEL_INTERP_NEAREST, EL_PIXEL_FIT_LETTERBOX)};
+        if (ret != EL_OK) [[unlikely]]
+            return ret;
     }
 
-    return EL_OK;
+    return _input_plan.execute(i_img, &_input_img);
 }
 
 namespace utils {
@@ -248,13 +246,13 @@ el_err_code_t AlgorithmYOLOPOSE::run(ImageType* input) {
         _last_input_width  = input->width;
         _last_input_height = input->height;
 
-        _w_scale = static_cast<float>(input->width) / static_cast<float>(_input_img.width);
-        _h_scale = static_cast<float>(input->height) / static_cast<float>(_input_img.height);
+        // the frame is letterboxed into the model input, boxes and keypoints are mapped back through the same fit
+        el_img_fit_map(input, &_input_img, EL_PIXEL_FIT_LETTERBOX, &_input_map);
 
         const auto size = std::min(_anchor_strides.size(), _scaled_strides.size());
         for (size_t i = 0; i < size; ++i) {
             auto stride        = static_cast<float>(_anchor_strides[i].stride);
-            _scaled_strides[i] = std::make_pair(stride * _w_scale, stride * _h_scale);
+            _scaled_strides[i] = std::make_pair(stride * _input_map.x_scale, stride * _input_map.y_scale);
         }
     }
 
@@ -274,6 +272,7 @@ inline void AlgorithmYOLOPOSE::init() {
       static_cast<decltype(ImageType::size)>(_input_img.width * _input_img.height * this->__input_shape.dims[3]);
     _input_img.format = EL_PIXEL_FORMAT_UNKNOWN;
     _input_img.rotate = EL_PIXEL_ROTATE_0;
+    _input_img.pitch  = 0;
     if (this->__input_shape.dims[3] == 3) {
         _input_img.format = EL_PIXEL_FORMAT_RGB888;
     } else if (this->__input_shape.dims[3] == 1) {
@@ -283,6 +282,8 @@ inline void AlgorithmYOLOPOSE::init() {
     EL_ASSERT(_input_img.format != EL_PIXEL_FORMAT_UNKNOWN);
     EL_ASSERT(_input_img.rotate != EL_PIXEL_ROTATE_UNKNOWN);
 
+    el_img_lut_from_quant(&_input_lut, &this->__input_quant);
+
     // inputs shape
     const auto width{this->__input_shape.dims[1]};
     const auto height{this->__input_shape.dims[2]};
@@ -299,8 +300,8 @@ inline void AlgorithmYOLOPOSE::init() {
 
     _scaled_strides.reserve(_anchor_strides.size());
     for (const auto& anchor_stride : _anchor_strides) {
-        _scaled_strides.emplace_back(std::make_pair(static_cast<float>(anchor_stride.stride) * _w_scale,
-                                                    static_cast<float>(anchor_stride.stride) * _h_scale));
+        _scaled_strides.emplace_back(std::make_pair(static_cast<float>(anchor_stride.stride) * _input_map.x_scale,
+                                                    static_cast<float>(anchor_stride.stride) * _input_map.y_scale));
     }
 
     for (size_t i = 0; i < _outputs; ++i) {
@@ -352,13 +353,17 @@ el_err_code_t AlgorithmYOLOPOSE::postprocess() {
 
     const int8_t* output_data[_outputs];
     for (size_t i = 0; i < _outputs; ++i) {
-        output_data[i] = static_cast<int8_t*>(this->__p_engine->get_output(i));
+        output_data[i] = static_cast<int8_t*>(this->get_output_data(i));
     }
 
     // post-process
     const float score_threshold = static_cast<float>(_score_threshold.load()) / 100.f;
     const float iou_threshold   = static_cast<float>(_iou_threshold.load()) / 100.f;
 
+    // letterbox offsets in frame coordinates, the strides are already scaled to the frame
+    const float shift_x = _input_map.x_offset * _input_map.x_scale;
+    const float shift_y = _input_map.y_offset * _input_map.y_scale;
+
     std::forward_list<types::anchor_bbox_t> anchor_bboxes;
 
     const auto anchor_matrix_size = _anchor_matrix.size();
@@ -408,10 +413,10 @@ el_err_code_t AlgorithmYOLOPOSE::postprocess() {
 
             const auto anchor = anchor_array[j];
 
-            float x1 = (anchor.x - dist[0]) * scale_w;
-            float y1 = (anchor.y - dist[1]) * scale_h;
-            float x2 = (anchor.x + dist[2]) * scale_w;
-            float y2 = (anchor.y + dist[3]) * scale_h;
+            float x1 = (anchor.x - dist[0]) * scale_w - shift_x;
+            float y1 = (anchor.y - dist[1]) * scale_h - shift_y;
+            float x2 = (anchor.x + dist[2]) * scale_w - shift_x;
+            float y2 = (anchor.y + dist[3]) * scale_h - shift_y;
 
             anchor_bboxes.emplace_front(types::anchor_bbox_t{
               .x1           = x1,
@@ -485,8 +490,8 @@ el_err_code_t AlgorithmYOLOPOSE::postprocess() {
         keypoint.pts.reserve(keypoint_nums);
         size_t target = 0;
         for (const auto& kp : n_keypoint) {
-            float x = kp.x * scale_w;
-            float y = kp.y * scale_h;
+            float x = kp.x * scale_w - shift_x;
+            float y = kp.y * scale_h - shift_y;
             float z = kp.z * 100.f;
             keypoint.pts.emplace_back(el_point_t{
               .x      = static_cast<decltype(el_point_t::x)>(std::round(x)),
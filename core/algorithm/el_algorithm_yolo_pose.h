@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "core/el_types.h"
+#include "core/utils/el_cv.h"
 #include "el_algorithm_base.h"
 
 namespace edgelab {
@@ -118,13 +119,14 @@ class AlgorithmYOLOPOSE final : public Algorithm {
     el_err_code_t postprocess() override;
 
    private:
-    ImageType _input_img;
+    ImageType      _input_img;
+    el_img_lut_t   _input_lut;
+    ImgConvertPlan _input_plan;
 
     decltype(ImageType::width)  _last_input_width;
     decltype(ImageType::height) _last_input_height;
 
-    float _w_scale;
-    float _h_scale;
+    el_img_map_t _input_map;
 
     std::atomic<ScoreType> _score_threshold;
     std::atomic<IoUType>   _iou_threshold;
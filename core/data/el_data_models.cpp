@@ -28,11 +28,43 @@
 #if CONFIG_EL_MODEL
 
     #include <algorithm>
+    #include <cstring>
+    #include <iterator>
 
     #include "porting/el_flash.h"
 
+    #if CONFIG_EL_MODEL_INDEX
+        #include "core/data/el_data_storage.hpp"
+        #include "core/utils/el_hash.h"
+    #endif
+
 namespace edgelab {
 
+    #if CONFIG_EL_MODEL_INDEX
+namespace {
+
+constexpr uint32_t MODEL_INDEX_MAGIC = 0x4D494458;
+constexpr char     MODEL_INDEX_KEY[] = "edgelab#models";
+
+// the models in the order they are listed, the partition and formats they were found with
+struct model_index_t {
+    uint32_t magic;
+    uint32_t partition_start_addr;
+    uint32_t partition_size;
+    uint32_t format;
+    uint32_t count;
+    struct {
+        uint32_t offset;  // of the model in the partition, past the header of packed ones
+        uint32_t size;    // 0 for plain models
+        uint8_t  id;
+        uint8_t  type;
+        uint16_t crc;  // of the leading bytes of the model
+    } models[16];  // one per bit of the model id mask
+};
+
+}  // namespace
+    #endif
+
 Models* Models::get_ptr() {
     static Models models{};
     return &models;
@@ -52,6 +84,10 @@ el_err_code_t Models::init(el_model_format_v model_format) {
     if (!porting::el_flash_mmap_init(
           &__partition_start_addr, &__partition_size, &__flash_2_memory_map, &__mmap_handler)) [[unlikely]]
         return EL_EIO;
+    #if CONFIG_EL_MODEL_INDEX
+    if (m_load_model_index(model_format)) [[likely]]
+        return EL_OK;
+    #endif
     seek_models_from_flash(model_format);
     return EL_OK;
 }
@@ -73,53 +109,44 @@ std::size_t Models::seek_models_from_flash(const el_model_format_v& model_format
     switch (model_format) {
     case EL_MODEL_FMT_PACKED_TFLITE:
         m_seek_packed_models_from_flash();
-        return std::distance(__model_info.begin(), __model_info.end());
+        break;
     case EL_MODEL_FMT_PLAIN_TFLITE:
         m_seek_plain_models_from_flash();
-        return std::distance(__model_info.begin(), __model_info.end());
+        break;
     case EL_MODEL_FMT_PACKED_TFLITE | EL_MODEL_FMT_PLAIN_TFLITE:
         m_seek_packed_models_from_flash();
         m_seek_plain_models_from_flash();
-        return std::distance(__model_info.begin(), __model_info.end());
+        break;
     default:
         return 0u;
     }
+
+    #if CONFIG_EL_MODEL_INDEX
+    m_store_model_index(model_format);
+    #endif
+
+    return std::distance(__model_info.begin(), __model_info.end());
 }
 
 void Models::m_seek_packed_models_from_flash() {
-    const uint8_t*           mem_addr = nullptr;
-    const el_model_header_t* header   = nullptr;
+    el_model_info_t model_info{};
     for (std::size_t it = 0u; it < __partition_size; it += CONFIG_EL_MODEL_SEEK_STEP_BYTES) {
-        mem_addr = __flash_2_memory_map + it;
-        header   = reinterpret_cast<const el_model_header_t*>(mem_addr);
-        if ((el_ntohl(header->b4[0]) & 0xFFFFFF00) != (CONFIG_EL_MODEL_HEADER_MAGIC << 8u)) continue;
-
-        uint8_t  model_id   = header->b1[3] >> 4u;
-        uint8_t  model_type = header->b1[3] & 0x0F;
-        uint32_t model_size = (el_ntohl(header->b4[1]) & 0xFFFFFF00) >> 8u;
-        if (!model_id || !model_type || !model_size || model_size > (__partition_size - it)) [[unlikely]]
-            continue;
+        if (!m_packed_model_at(it, model_info)) continue;
 
-        if (~__model_id_mask & (1u << model_id)) {
-            __model_info.emplace_front(el_model_info_t{.id          = model_id,
-                                                       .type        = static_cast<el_algorithm_type_t>(model_type),
-                                                       .addr_flash  = __partition_start_addr + it,
-                                                       .size        = model_size,
-                                                       .addr_memory = mem_addr + sizeof(el_model_header_t)});
-            __model_id_mask |= (1u << model_id);
+        if (~__model_id_mask & (1u << model_info.id)) {
+            __model_info.emplace_front(model_info);
+            __model_id_mask |= (1u << model_info.id);
         }
-        it += model_size;
+        it += model_info.size;
     }
 }
 
 void Models::m_seek_plain_models_from_flash() {
-    const uint8_t*           mem_addr = nullptr;
-    const el_model_header_t* header   = nullptr;
-    uint8_t                  model_id = 1u;
+    const uint8_t* mem_addr = nullptr;
+    uint8_t        model_id = 1u;
     for (std::size_t it = 0u; it < __partition_size; it += CONFIG_EL_MODEL_SEEK_STEP_BYTES) {
         mem_addr = __flash_2_memory_map + it;
-        header   = reinterpret_cast<const el_model_header_t*>(mem_addr);
-        if (el_ntohl(header->b4[1]) != CONFIG_EL_MODEL_TFLITE_MAGIC) [[likely]]
+        if (!m_plain_model_at(it)) [[likely]]
             continue;
 
         if (std::find_if(__model_info.begin(), __model_info.end(), [&](const el_model_info_t& v) {
@@ -140,6 +167,121 @@ void Models::m_seek_plain_models_from_flash() {
     }
 }
 
+bool Models::m_packed_model_at(std::size_t offset, el_model_info_t& model_info) const {
+    const uint8_t* mem_addr = __flash_2_memory_map + offset;
+    const auto*    header   = reinterpret_cast<const el_model_header_t*>(mem_addr);
+    if ((el_ntohl(header->b4[0]) & 0xFFFFFF00) != (CONFIG_EL_MODEL_HEADER_MAGIC << 8u)) return false;
+
+    uint8_t  model_id   = header->b1[3] >> 4u;
+    uint8_t  model_type = header->b1[3] & 0x0F;
+    uint32_t model_size = (el_ntohl(header->b4[1]) & 0xFFFFFF00) >> 8u;
+    if (!model_id || !model_type || !model_size || model_size > (__partition_size - offset)) [[unlikely]]
+        return false;
+
+    model_info = el_model_info_t{.id          = model_id,
+                                 .type        = static_cast<el_algorithm_type_t>(model_type),
+                                 .addr_flash  = __partition_start_addr + static_cast<uint32_t>(offset),
+                                 .size        = model_size,
+                                 .addr_memory = mem_addr + sizeof(el_model_header_t)};
+    return true;
+}
+
+bool Models::m_plain_model_at(std::size_t offset) const {
+    const auto* header = reinterpret_cast<const el_model_header_t*>(__flash_2_memory_map + offset);
+    return el_ntohl(header->b4[1]) == CONFIG_EL_MODEL_TFLITE_MAGIC;
+}
+
+    #if CONFIG_EL_MODEL_INDEX
+// the index is only trusted while the partition is the same one and every model it lists is still in place with the
+// same header and leading bytes, a model flashed to an unused part of the partition since is found by seeking again
+bool Models::m_load_model_index(const el_model_format_v& model_format) {
+    auto* storage = Storage::get_ptr();
+    if (!storage->is_ready() || storage->get_value_size(MODEL_INDEX_KEY) != sizeof(model_index_t)) return false;
+
+    model_index_t index{};
+    if (!storage->get(utility::el_make_storage_kv(MODEL_INDEX_KEY, index))) return false;
+    if (index.magic != MODEL_INDEX_MAGIC || index.partition_start_addr != __partition_start_addr ||
+        index.partition_size != __partition_size || index.format != static_cast<uint32_t>(model_format) ||
+        !index.count || index.count > std::size(index.models))
+        return false;
+
+    __model_id_mask = 0u;
+    __model_info.clear();
+
+    // listed front to back, so added back to front
+    for (uint32_t i = index.count; i-- > 0u;) {
+        const auto& model = index.models[i];
+        bool valid = model.id && model.id < (sizeof(__model_id_mask) << 3u) && (~__model_id_mask & (1u << model.id)) &&
+                     model.offset <= __partition_size - sizeof(el_model_header_t);
+
+        auto model_info = el_model_info_t{.id          = model.id,
+                                          .type        = EL_ALGO_TYPE_UNDEFINED,
+                                          .addr_flash  = __partition_start_addr + model.offset,
+                                          .size        = 0u,
+                                          .addr_memory = __flash_2_memory_map + model.offset};
+        if (valid && model.size)
+            valid = model.offset >= sizeof(el_model_header_t) &&
+                    m_packed_model_at(model.offset - sizeof(el_model_header_t), model_info) &&
+                    model_info.id == model.id && model_info.type == model.type && model_info.size == model.size;
+        else if (valid)
+            valid = m_plain_model_at(model.offset);
+
+        if (!valid || m_model_crc(model.offset) != model.crc) {
+            __model_id_mask = 0u;
+            __model_info.clear();
+            return false;
+        }
+
+        __model_info.emplace_front(model_info);
+        __model_id_mask |= (1u << model.id);
+    }
+
+    return true;
+}
+
+// nothing is kept for an empty partition, models are flashed to it later without the index knowing
+void Models::m_store_model_index(const el_model_format_v& model_format) const {
+    auto* storage = Storage::get_ptr();
+    if (!storage->is_ready()) return;
+
+    model_index_t index{};
+    index.magic                = MODEL_INDEX_MAGIC;
+    index.partition_start_addr = __partition_start_addr;
+    index.partition_size       = __partition_size;
+    index.format               = static_cast<uint32_t>(model_format);
+    for (const auto& model_info : __model_info) {
+        if (index.count >= std::size(index.models)) [[unlikely]]
+            return;
+        auto& model  = index.models[index.count++];
+        model.offset = static_cast<uint32_t>(model_info.addr_memory - __flash_2_memory_map);
+        model.size   = model_info.size;
+        model.id     = model_info.id;
+        model.type   = static_cast<uint8_t>(model_info.type);
+        model.crc    = m_model_crc(model.offset);
+    }
+
+    if (!index.count) {
+        if (storage->contains(MODEL_INDEX_KEY)) storage->erase(MODEL_INDEX_KEY);
+        return;
+    }
+
+    // a rescan finding the same models leaves the record alone, flash is not worn by every lookup of a missing id
+    model_index_t stored{};
+    if (storage->get_value_size(MODEL_INDEX_KEY) == sizeof(model_index_t) &&
+        storage->get(utility::el_make_storage_kv(MODEL_INDEX_KEY, stored)) &&
+        std::memcmp(&stored, &index, sizeof(model_index_t)) == 0)
+        return;
+    if (!storage->emplace(utility::el_make_storage_kv(MODEL_INDEX_KEY, index))) {
+        EL_LOGD("model index not stored");
+    }
+}
+
+uint16_t Models::m_model_crc(std::size_t offset) const {
+    return el_crc16_maxim(__flash_2_memory_map + offset,
+                          std::min<std::size_t>(CONFIG_EL_MODEL_INDEX_CRC_BYTES, __partition_size - offset));
+}
+    #endif
+
 bool Models::has_model(el_model_id_t model_id) const { return __model_id_mask & (1u << model_id); }
 
 el_err_code_t Models::get(el_model_id_t model_id, el_model_info_t& model_info) const {
@@ -61,6 +61,14 @@ class Models {
     Models();
     void m_seek_packed_models_from_flash();
     void m_seek_plain_models_from_flash();
+    bool m_packed_model_at(std::size_t offset, el_model_info_t& model_info) const;
+    bool m_plain_model_at(std::size_t offset) const;
+
+    #if CONFIG_EL_MODEL_INDEX
+    bool     m_load_model_index(const el_model_format_v& model_format);
+    void     m_store_model_index(const el_model_format_v& model_format) const;
+    uint16_t m_model_crc(std::size_t offset) const;
+    #endif
 
    private:
     uint32_t                           __partition_start_addr;
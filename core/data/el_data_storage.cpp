@@ -61,6 +61,15 @@ void Storage::deinit() {
     #endif
 }
 
+bool Storage::is_ready() const {
+    const Guard<Mutex> guard(__lock);
+    #if CONFIG_EL_LIB_FLASHDB
+    return __kvdb && __kvdb->parent.init_ok;
+    #else
+    return true;
+    #endif
+}
+
 bool Storage::contains(const char* key) const {
     const Guard<Mutex> guard(__lock);
     #if CONFIG_EL_LIB_FLASHDB
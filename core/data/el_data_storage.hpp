@@ -159,6 +159,7 @@ class Storage {
 
     el_err_code_t init(const char* name = CONFIG_EL_STORAGE_NAME, const char* path = CONFIG_EL_STORAGE_PATH);
     void          deinit();
+    bool          is_ready() const;
 
     struct Iterator {
         using iterator_category = std::forward_iterator_tag;
@@ -54,6 +54,16 @@
     #define CONFIG_EL_HAS_FREERTOS_SUPPORT 1
 #endif
 
+#ifndef CONFIG_EL_HAS_PTHREAD_SUPPORT
+    #define CONFIG_EL_HAS_PTHREAD_SUPPORT 0
+#endif
+
+/* memory related config */
+#ifndef CONFIG_EL_HEAP_REGIONS_MAX
+    // blocks of memory that can be lent to el_malloc at runtime, see core/utils/el_heap.h
+    #define CONFIG_EL_HEAP_REGIONS_MAX 4
+#endif
+
 /* engine related config */
 #ifndef CONFIG_EL_TFLITE
     #define CONFIG_EL_TFLITE
@@ -83,6 +93,41 @@
     #define CONFIG_EL_TFLITE_OP_LEAKY_RELU
 #endif
 
+#ifndef CONFIG_EL_TFLITE_MODEL_OPS_MAX
+    // distinct operators a per model resolver holds, models using more (or 0 here) get the full compiled in set
+    #define CONFIG_EL_TFLITE_MODEL_OPS_MAX 32
+#endif
+
+#ifndef CONFIG_EL_ENGINE_RESIDENT_MODELS_MAX
+    // prepared interpreters kept side by side in the tensor arena, switching back to one of them skips allocation
+    #define CONFIG_EL_ENGINE_RESIDENT_MODELS_MAX 2
+#endif
+
+#ifndef CONFIG_EL_ENGINE_MEMORY_PLAN_CACHE
+    // arena layouts computed by the tensor allocator are kept in storage and reused when a model is prepared again
+    #define CONFIG_EL_ENGINE_MEMORY_PLAN_CACHE CONFIG_EL_STORAGE
+#endif
+
+#ifndef CONFIG_EL_ENGINE_MEMORY_PLAN_SLOTS
+    // storage records the cached plans rotate through, one per resident interpreter by default
+    #define CONFIG_EL_ENGINE_MEMORY_PLAN_SLOTS CONFIG_EL_ENGINE_RESIDENT_MODELS_MAX
+#endif
+
+#ifndef CONFIG_EL_ENGINE_PROFILER
+    // per node operator timing, switched on at runtime, the tables are only allocated while enabled
+    #define CONFIG_EL_ENGINE_PROFILER 1
+#endif
+
+#ifndef CONFIG_EL_ENGINE_PROFILER_NODES_MAX
+    #define CONFIG_EL_ENGINE_PROFILER_NODES_MAX 256
+#endif
+
+#ifndef CONFIG_EL_ENGINE_ASYNC
+    // asynchronous runs are invoked on a worker thread of the engine, needs std::thread, without it they complete
+    // before run_async() returns
+    #define CONFIG_EL_ENGINE_ASYNC 0
+#endif
+
 /* model related config */
 #ifndef CONFIG_EL_MODEL
     #define CONFIG_EL_MODEL                 1
@@ -92,11 +137,42 @@
     #define CONFIG_EL_MODEL_SEEK_STEP_BYTES sizeof(el_model_header_t)
 #endif
 
+#ifndef CONFIG_EL_MODEL_INDEX
+    // where the models were found is kept in storage and only checked on init instead of scanning the whole
+    // partition again, seeking the models explicitly always scans and refreshes it
+    #define CONFIG_EL_MODEL_INDEX CONFIG_EL_STORAGE
+#endif
+
+#ifndef CONFIG_EL_MODEL_INDEX_CRC_BYTES
+    // leading bytes of each model the check covers
+    #define CONFIG_EL_MODEL_INDEX_CRC_BYTES 256
+#endif
+
 /* sensor related config */
 #ifndef CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC
     #define CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC 0
 #endif
 
+/* image processing config */
+#ifndef CONFIG_EL_CV_SIMD
+    // vectorized pixel converters built on the GCC/Clang vector extensions, little endian hosts only
+    #if defined(__GNUC__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        #define CONFIG_EL_CV_SIMD 1
+    #else
+        #define CONFIG_EL_CV_SIMD 0
+    #endif
+#endif
+
+#ifndef CONFIG_EL_CV_THREADS
+    // threads (the caller included) the conversion plans split destination rows across, needs std::thread
+    #define CONFIG_EL_CV_THREADS 1
+#endif
+
+#ifndef CONFIG_EL_CV_THREADS_MIN_PIXELS
+    // smaller destinations are converted on the calling thread, waking the workers would cost more than it saves
+    #define CONFIG_EL_CV_THREADS_MIN_PIXELS (160 * 120)
+#endif
+
 /* third-party libraries */
 #ifndef CONFIG_EL_LIB_FLASHDB
     #define CONFIG_EL_LIB_FLASHDB 1
@@ -115,6 +115,11 @@ typedef enum {
     EL_PIXEL_FORMAT_YUV422,
     EL_PIXEL_FORMAT_GRAYSCALE,
     EL_PIXEL_FORMAT_JPEG,
+    EL_PIXEL_FORMAT_YUYV,
+    EL_PIXEL_FORMAT_UYVY,
+    EL_PIXEL_FORMAT_NV12,
+    EL_PIXEL_FORMAT_NV21,
+    EL_PIXEL_FORMAT_RGB888_PLANAR,  // red, green and blue planes of width x height bytes one after the other
     EL_PIXEL_FORMAT_UNKNOWN,
 } el_pixel_format_t;
 
@@ -126,6 +131,19 @@ typedef enum el_pixel_rotate_t {
     EL_PIXEL_ROTATE_UNKNOWN,
 } el_pixel_rotate_t;
 
+typedef enum el_pixel_interp_t {
+    EL_PIXEL_INTERP_NEAREST = 0,
+    EL_PIXEL_INTERP_BILINEAR,
+    EL_PIXEL_INTERP_AREA,
+    EL_PIXEL_INTERP_UNKNOWN,
+} el_pixel_interp_t;
+
+typedef enum el_pixel_fit_t {
+    EL_PIXEL_FIT_STRETCH = 0,
+    EL_PIXEL_FIT_LETTERBOX,
+    EL_PIXEL_FIT_UNKNOWN,
+} el_pixel_fit_t;
+
 typedef struct EL_ATTR_PACKED el_img_t {
     uint8_t*          data;
     size_t            size;
@@ -133,6 +151,7 @@ typedef struct EL_ATTR_PACKED el_img_t {
     uint16_t          height;
     el_pixel_format_t format;
     el_pixel_rotate_t rotate;
+    uint32_t          pitch;  // bytes per row as stored in memory, 0 if the rows are tightly packed
 } el_img_t;
 
 typedef struct EL_ATTR_PACKED el_res_t {
@@ -214,6 +233,26 @@ typedef struct EL_ATTR_PACKED el_model_info_t {
 
 typedef uint8_t el_model_id_t;
 
+typedef struct el_op_profile_t {
+    const char* tag;       // operator name, owned by the engine
+    uint32_t    count;     // times the node ran
+    uint32_t    max_us;    // slowest single run
+    uint64_t    total_us;  // all runs summed
+} el_op_profile_t;
+
+typedef struct el_engine_profile_t {
+    const el_op_profile_t* nodes;        // one entry per executed node, in execution order
+    size_t                 size;         // nodes timed, 0 when profiling is disabled
+    uint32_t               invocations;  // invocations since profiling was enabled or the model was loaded
+} el_engine_profile_t;
+
+typedef struct el_engine_memory_t {
+    size_t size;   // memory pool the engine was given
+    size_t used;   // taken by the prepared models, the current one included
+    size_t model;  // taken by the current model once its tensors are allocated
+    size_t peak;   // highest used since the engine was given its pool
+} el_engine_memory_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,6 +49,19 @@ class Engine {
 
     virtual el_err_code_t run() = 0;
 
+    // starts a run and returns while it goes on where the engine supports it, the callback is called from where the
+    // run took place once it is done, inputs must be left alone and outputs not read until wait() returns
+    virtual el_err_code_t run_async(void (*callback)(el_err_code_t ret, void* user) = nullptr,
+                                    void* user                                       = nullptr) = 0;
+
+    // blocks until the last run started is done and returns its result
+    virtual el_err_code_t wait() = 0;
+
+    // runs many items through the model, as many per run as the model's batch size, one at a time for models of
+    // batch size 1, item i is copied into inputs[i].index and its results out of outputs[i].index, sizes are those of
+    // a single item
+    virtual el_err_code_t run_batch(const el_tensor_t* inputs, el_tensor_t* outputs, size_t count) = 0;
+
 #ifdef CONFIG_EL_FILESYSTEM
     virtual el_err_code_t load_model(const char* model_path) = 0;
 #endif
@@ -65,6 +78,17 @@ class Engine {
     virtual el_quant_param_t get_input_quant_param(size_t index) const  = 0;
     virtual el_quant_param_t get_output_quant_param(size_t index) const = 0;
 
+    // bytes the tensor takes whatever its element type, 0 for an index the model has no tensor at
+    virtual size_t get_input_size(size_t index) const  = 0;
+    virtual size_t get_output_size(size_t index) const = 0;
+
+    // enabling clears the timings collected so far, disabling releases them, a profile waits for the run in flight and
+    // points into the engine's own tables, it is read before the next run is started
+    virtual el_err_code_t set_profiling(bool enable)                     = 0;
+    virtual el_err_code_t get_profile(el_engine_profile_t* profile) const = 0;
+
+    virtual el_err_code_t get_memory_usage(el_engine_memory_t* memory) const = 0;
+
 #ifdef CONFIG_EL_INFERENCER_TENSOR_NAME
     virtual size_t           get_input_index(const char* input_name) const                                = 0;
     virtual size_t           get_output_index(const char* output_name) const                              = 0;
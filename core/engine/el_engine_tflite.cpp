@@ -25,8 +25,26 @@
 
 #include "el_engine_tflite.h"
 
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+    #if defined(CONFIG_EL_FILESYSTEM) && CONFIG_EL_PORTING_POSIX
+        #include <fcntl.h>
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+        #include <unistd.h>
+
+        #include <algorithm>
+    #endif
+
+#include "core/el_common.h"
 #include "core/el_debug.h"
 
+#if CONFIG_EL_ENGINE_MEMORY_PLAN_CACHE
+    #include "core/data/el_data_storage.hpp"
+#endif
+
 #ifdef CONFIG_EL_TFLITE
 
 namespace tflite {
@@ -325,34 +343,802 @@ OpsResolver::OpsResolver() {
     #endif
 }
 
+
+    #if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+TfLiteStatus ModelOpsResolver::AddModelOps(const Model* model) {
+    if (model == nullptr || model->operator_codes() == nullptr) {
+        return kTfLiteError;
+    }
+    for (const auto* code : *model->operator_codes()) {
+        if (AddOp(code) != kTfLiteOk) {
+            return kTfLiteError;
+        }
+    }
+    return kTfLiteOk;
+}
+
+// an operator listed once per version is registered once
+TfLiteStatus ModelOpsResolver::AddOp(const OperatorCode* code) {
+    auto builtin = GetBuiltinCode(code);
+    if (builtin == BuiltinOperator_CUSTOM) {
+        const char* name = code->custom_code() ? code->custom_code()->c_str() : "";
+        if (FindOp(name) != nullptr) {
+            return kTfLiteOk;
+        }
+        #ifdef CONFIG_EL_TFLITE_OP_CIRULAR_BUFFER
+        if (std::strcmp(name, "CIRCULAR_BUFFER") == 0) {
+            return AddCircularBuffer();
+        }
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_DETECTION_POSTPROCESS
+        if (std::strcmp(name, "TFLite_Detection_PostProcess") == 0) {
+            return AddDetectionPostprocess();
+        }
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ETHOS_U
+        if (std::strcmp(name, "ethos-u") == 0) {
+            return AddEthosU();
+        }
+        #endif
+        return kTfLiteError;
+    }
+    if (FindOp(builtin) != nullptr) {
+        return kTfLiteOk;
+    }
+    switch (builtin) {
+        #ifdef CONFIG_EL_TFLITE_OP_ABS
+    case BuiltinOperator_ABS:
+        return AddAbs();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ADD
+    case BuiltinOperator_ADD:
+        return AddAdd();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ADDN
+    case BuiltinOperator_ADD_N:
+        return AddAddN();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ARGMAX
+    case BuiltinOperator_ARG_MAX:
+        return AddArgMax();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ARGMIN
+    case BuiltinOperator_ARG_MIN:
+        return AddArgMin();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ASSIGN_VARIABLE
+    case BuiltinOperator_ASSIGN_VARIABLE:
+        return AddAssignVariable();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_AVERAGE_POOL_2D
+    case BuiltinOperator_AVERAGE_POOL_2D:
+        return AddAveragePool2D();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_BATCH_TO_SPACE_ND
+    case BuiltinOperator_BATCH_TO_SPACE_ND:
+        return AddBatchToSpaceNd();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_BROADCAST_ARGS
+    case BuiltinOperator_BROADCAST_ARGS:
+        return AddBroadcastArgs();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_BROADCAST_TO
+    case BuiltinOperator_BROADCAST_TO:
+        return AddBroadcastTo();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_CALL_ONCE
+    case BuiltinOperator_CALL_ONCE:
+        return AddCallOnce();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_CAST
+    case BuiltinOperator_CAST:
+        return AddCast();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_CEIL
+    case BuiltinOperator_CEIL:
+        return AddCeil();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_CONCATENATION
+    case BuiltinOperator_CONCATENATION:
+        return AddConcatenation();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_CONV_2D
+    case BuiltinOperator_CONV_2D:
+        return AddConv2D();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_COS
+    case BuiltinOperator_COS:
+        return AddCos();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_CUM_SUM
+    case BuiltinOperator_CUMSUM:
+        return AddCumSum();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_DEPTH_TO_SPACE
+    case BuiltinOperator_DEPTH_TO_SPACE:
+        return AddDepthToSpace();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_DEPTHWISE_CONV_2D
+    case BuiltinOperator_DEPTHWISE_CONV_2D:
+        return AddDepthwiseConv2D();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_DEQUANTIZE
+    case BuiltinOperator_DEQUANTIZE:
+        return AddDequantize();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_DIV
+    case BuiltinOperator_DIV:
+        return AddDiv();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ELU
+    case BuiltinOperator_ELU:
+        return AddElu();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_EQUAL
+    case BuiltinOperator_EQUAL:
+        return AddEqual();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_EXP
+    case BuiltinOperator_EXP:
+        return AddExp();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_EXPAND_DIMS
+    case BuiltinOperator_EXPAND_DIMS:
+        return AddExpandDims();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_FILL
+    case BuiltinOperator_FILL:
+        return AddFill();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_FLOOR
+    case BuiltinOperator_FLOOR:
+        return AddFloor();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_FLOOR_DIV
+    case BuiltinOperator_FLOOR_DIV:
+        return AddFloorDiv();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_FLOOR_MOD
+    case BuiltinOperator_FLOOR_MOD:
+        return AddFloorMod();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_FULLY_CONNECTED
+    case BuiltinOperator_FULLY_CONNECTED:
+        return AddFullyConnected();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_GATHER
+    case BuiltinOperator_GATHER:
+        return AddGather();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_GATHER_ND
+    case BuiltinOperator_GATHER_ND:
+        return AddGatherNd();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_GREATER
+    case BuiltinOperator_GREATER:
+        return AddGreater();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_GREATER_EQUAL
+    case BuiltinOperator_GREATER_EQUAL:
+        return AddGreaterEqual();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_HARD_SWISH
+    case BuiltinOperator_HARD_SWISH:
+        return AddHardSwish();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_IF
+    case BuiltinOperator_IF:
+        return AddIf();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_L2_NORMALIZATION
+    case BuiltinOperator_L2_NORMALIZATION:
+        return AddL2Normalization();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_L2_POOL_2D
+    case BuiltinOperator_L2_POOL_2D:
+        return AddL2Pool2D();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LEAKY_RELU
+    case BuiltinOperator_LEAKY_RELU:
+        return AddLeakyRelu();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LESS
+    case BuiltinOperator_LESS:
+        return AddLess();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LESS_EQUAL
+    case BuiltinOperator_LESS_EQUAL:
+        return AddLessEqual();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LOG
+    case BuiltinOperator_LOG:
+        return AddLog();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LOGICAL_AND
+    case BuiltinOperator_LOGICAL_AND:
+        return AddLogicalAnd();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LOGICAL_NOT
+    case BuiltinOperator_LOGICAL_NOT:
+        return AddLogicalNot();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LOGICAL_OR
+    case BuiltinOperator_LOGICAL_OR:
+        return AddLogicalOr();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LOGISTIC
+    case BuiltinOperator_LOGISTIC:
+        return AddLogistic();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_LOG_SOFTMAX
+    case BuiltinOperator_LOG_SOFTMAX:
+        return AddLogSoftmax();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_MAX_POOL_2D
+    case BuiltinOperator_MAX_POOL_2D:
+        return AddMaxPool2D();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_MAXIMUM
+    case BuiltinOperator_MAXIMUM:
+        return AddMaximum();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_MEAN
+    case BuiltinOperator_MEAN:
+        return AddMean();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_MINIMUM
+    case BuiltinOperator_MINIMUM:
+        return AddMinimum();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_MIRROR_PAD
+    case BuiltinOperator_MIRROR_PAD:
+        return AddMirrorPad();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_MUL
+    case BuiltinOperator_MUL:
+        return AddMul();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_NEG
+    case BuiltinOperator_NEG:
+        return AddNeg();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_NOT_EQUAL
+    case BuiltinOperator_NOT_EQUAL:
+        return AddNotEqual();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_PACK
+    case BuiltinOperator_PACK:
+        return AddPack();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_PAD
+    case BuiltinOperator_PAD:
+        return AddPad();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_PADV2
+    case BuiltinOperator_PADV2:
+        return AddPadV2();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_PRELU
+    case BuiltinOperator_PRELU:
+        return AddPrelu();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_QUANTIZE
+    case BuiltinOperator_QUANTIZE:
+        return AddQuantize();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_READ_VARIABLE
+    case BuiltinOperator_READ_VARIABLE:
+        return AddReadVariable();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_REDUCE_ANY
+    case BuiltinOperator_REDUCE_MAX:
+        return AddReduceMax();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_RELU
+    case BuiltinOperator_RELU:
+        return AddRelu();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_RELU6
+    case BuiltinOperator_RELU6:
+        return AddRelu6();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_RESHAPE
+    case BuiltinOperator_RESHAPE:
+        return AddReshape();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_RESIZE_BILINEAR
+    case BuiltinOperator_RESIZE_BILINEAR:
+        return AddResizeBilinear();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_RESIZE_NEAREST_NEIGHBOR
+    case BuiltinOperator_RESIZE_NEAREST_NEIGHBOR:
+        return AddResizeNearestNeighbor();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ROUND
+    case BuiltinOperator_ROUND:
+        return AddRound();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_RSQRT
+    case BuiltinOperator_RSQRT:
+        return AddRsqrt();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SELECT_V2
+    case BuiltinOperator_SELECT_V2:
+        return AddSelectV2();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SHAPE
+    case BuiltinOperator_SHAPE:
+        return AddShape();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SIN
+    case BuiltinOperator_SIN:
+        return AddSin();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SLICE
+    case BuiltinOperator_SLICE:
+        return AddSlice();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SOFTMAX
+    case BuiltinOperator_SOFTMAX:
+        return AddSoftmax();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SPACE_TO_BATCH_ND
+    case BuiltinOperator_SPACE_TO_BATCH_ND:
+        return AddSpaceToBatchNd();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SPACE_TO_DEPTH
+    case BuiltinOperator_SPACE_TO_DEPTH:
+        return AddSpaceToDepth();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SPLIT
+    case BuiltinOperator_SPLIT:
+        return AddSplit();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SPLIT_V
+    case BuiltinOperator_SPLIT_V:
+        return AddSplitV();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SQRT
+    case BuiltinOperator_SQRT:
+        return AddSqrt();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SQUARE
+    case BuiltinOperator_SQUARE:
+        return AddSquare();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SQUARED_DIFFERENCE
+    case BuiltinOperator_SQUARED_DIFFERENCE:
+        return AddSquaredDifference();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SQUEEZE
+    case BuiltinOperator_SQUEEZE:
+        return AddSqueeze();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_STRIDED_SLICE
+    case BuiltinOperator_STRIDED_SLICE:
+        return AddStridedSlice();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SUB
+    case BuiltinOperator_SUB:
+        return AddSub();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_SUM
+    case BuiltinOperator_SUM:
+        return AddSum();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_SVDF
+    case BuiltinOperator_SVDF:
+        return AddSvdf();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_TANH
+    case BuiltinOperator_TANH:
+        return AddTanh();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_TRANSPOSE
+    case BuiltinOperator_TRANSPOSE:
+        return AddTranspose();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_TRANSPOSE_CONV
+    case BuiltinOperator_TRANSPOSE_CONV:
+        return AddTransposeConv();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_UNIDIRECTIONAL_SEQUENCE_LSTM
+    case BuiltinOperator_UNIDIRECTIONAL_SEQUENCE_LSTM:
+        return AddUnidirectionalSequenceLSTM();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_UNPACK
+    case BuiltinOperator_UNPACK:
+        return AddUnpack();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_VARHANDLE
+    case BuiltinOperator_VAR_HANDLE:
+        return AddVarHandle();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_WHILE
+    case BuiltinOperator_WHILE:
+        return AddWhile();
+        #endif
+        #ifdef CONFIG_EL_TFLITE_OP_ZEROS_LIKE
+    case BuiltinOperator_ZEROS_LIKE:
+        return AddZerosLike();
+        #endif
+    default:
+        return kTfLiteError;
+    }
+}
+    #endif
+
+// every operator the engine knows with the CONFIG_EL_TFLITE_ define that compiles it in, whether or not this
+// build does
+struct builtin_op_config_t {
+    BuiltinOperator builtin;
+    const char*     define;
+};
+
+struct custom_op_config_t {
+    const char* name;
+    const char* define;
+};
+
+constexpr builtin_op_config_t BUILTIN_OP_CONFIGS[] = {
+  {                         BuiltinOperator_ABS,                          "OP_ABS"},
+  {                         BuiltinOperator_ADD,                          "OP_ADD"},
+  {                       BuiltinOperator_ADD_N,                         "OP_ADDN"},
+  {                     BuiltinOperator_ARG_MAX,                       "OP_ARGMAX"},
+  {                     BuiltinOperator_ARG_MIN,                       "OP_ARGMIN"},
+  {             BuiltinOperator_ASSIGN_VARIABLE,              "OP_ASSIGN_VARIABLE"},
+  {             BuiltinOperator_AVERAGE_POOL_2D,              "OP_AVERAGE_POOL_2D"},
+  {           BuiltinOperator_BATCH_TO_SPACE_ND,            "OP_BATCH_TO_SPACE_ND"},
+  {              BuiltinOperator_BROADCAST_ARGS,               "OP_BROADCAST_ARGS"},
+  {                BuiltinOperator_BROADCAST_TO,                 "OP_BROADCAST_TO"},
+  {                   BuiltinOperator_CALL_ONCE,                    "OP_CALL_ONCE"},
+  {                        BuiltinOperator_CAST,                         "OP_CAST"},
+  {                        BuiltinOperator_CEIL,                         "OP_CEIL"},
+  {               BuiltinOperator_CONCATENATION,                "OP_CONCATENATION"},
+  {                     BuiltinOperator_CONV_2D,                      "OP_CONV_2D"},
+  {                         BuiltinOperator_COS,                          "OP_COS"},
+  {                      BuiltinOperator_CUMSUM,                      "OP_CUM_SUM"},
+  {              BuiltinOperator_DEPTH_TO_SPACE,               "OP_DEPTH_TO_SPACE"},
+  {           BuiltinOperator_DEPTHWISE_CONV_2D,            "OP_DEPTHWISE_CONV_2D"},
+  {                  BuiltinOperator_DEQUANTIZE,                   "OP_DEQUANTIZE"},
+  {                         BuiltinOperator_DIV,                          "OP_DIV"},
+  {                         BuiltinOperator_ELU,                          "OP_ELU"},
+  {                       BuiltinOperator_EQUAL,                        "OP_EQUAL"},
+  {                         BuiltinOperator_EXP,                          "OP_EXP"},
+  {                 BuiltinOperator_EXPAND_DIMS,                  "OP_EXPAND_DIMS"},
+  {                        BuiltinOperator_FILL,                         "OP_FILL"},
+  {                       BuiltinOperator_FLOOR,                        "OP_FLOOR"},
+  {                   BuiltinOperator_FLOOR_DIV,                    "OP_FLOOR_DIV"},
+  {                   BuiltinOperator_FLOOR_MOD,                    "OP_FLOOR_MOD"},
+  {             BuiltinOperator_FULLY_CONNECTED,              "OP_FULLY_CONNECTED"},
+  {                      BuiltinOperator_GATHER,                       "OP_GATHER"},
+  {                   BuiltinOperator_GATHER_ND,                    "OP_GATHER_ND"},
+  {                     BuiltinOperator_GREATER,                      "OP_GREATER"},
+  {               BuiltinOperator_GREATER_EQUAL,                "OP_GREATER_EQUAL"},
+  {                  BuiltinOperator_HARD_SWISH,                   "OP_HARD_SWISH"},
+  {                          BuiltinOperator_IF,                           "OP_IF"},
+  {            BuiltinOperator_L2_NORMALIZATION,             "OP_L2_NORMALIZATION"},
+  {                  BuiltinOperator_L2_POOL_2D,                   "OP_L2_POOL_2D"},
+  {                  BuiltinOperator_LEAKY_RELU,                   "OP_LEAKY_RELU"},
+  {                        BuiltinOperator_LESS,                         "OP_LESS"},
+  {                  BuiltinOperator_LESS_EQUAL,                   "OP_LESS_EQUAL"},
+  {                         BuiltinOperator_LOG,                          "OP_LOG"},
+  {                 BuiltinOperator_LOGICAL_AND,                  "OP_LOGICAL_AND"},
+  {                 BuiltinOperator_LOGICAL_NOT,                  "OP_LOGICAL_NOT"},
+  {                  BuiltinOperator_LOGICAL_OR,                   "OP_LOGICAL_OR"},
+  {                    BuiltinOperator_LOGISTIC,                     "OP_LOGISTIC"},
+  {                 BuiltinOperator_LOG_SOFTMAX,                  "OP_LOG_SOFTMAX"},
+  {                 BuiltinOperator_MAX_POOL_2D,                  "OP_MAX_POOL_2D"},
+  {                     BuiltinOperator_MAXIMUM,                      "OP_MAXIMUM"},
+  {                        BuiltinOperator_MEAN,                         "OP_MEAN"},
+  {                     BuiltinOperator_MINIMUM,                      "OP_MINIMUM"},
+  {                  BuiltinOperator_MIRROR_PAD,                   "OP_MIRROR_PAD"},
+  {                         BuiltinOperator_MUL,                          "OP_MUL"},
+  {                         BuiltinOperator_NEG,                          "OP_NEG"},
+  {                   BuiltinOperator_NOT_EQUAL,                    "OP_NOT_EQUAL"},
+  {                        BuiltinOperator_PACK,                         "OP_PACK"},
+  {                         BuiltinOperator_PAD,                          "OP_PAD"},
+  {                       BuiltinOperator_PADV2,                        "OP_PADV2"},
+  {                       BuiltinOperator_PRELU,                        "OP_PRELU"},
+  {                    BuiltinOperator_QUANTIZE,                     "OP_QUANTIZE"},
+  {               BuiltinOperator_READ_VARIABLE,                "OP_READ_VARIABLE"},
+  {                  BuiltinOperator_REDUCE_MAX,                   "OP_REDUCE_ANY"},
+  {                        BuiltinOperator_RELU,                         "OP_RELU"},
+  {                       BuiltinOperator_RELU6,                        "OP_RELU6"},
+  {                     BuiltinOperator_RESHAPE,                      "OP_RESHAPE"},
+  {             BuiltinOperator_RESIZE_BILINEAR,              "OP_RESIZE_BILINEAR"},
+  {     BuiltinOperator_RESIZE_NEAREST_NEIGHBOR,      "OP_RESIZE_NEAREST_NEIGHBOR"},
+  {                       BuiltinOperator_ROUND,                        "OP_ROUND"},
+  {                       BuiltinOperator_RSQRT,                        "OP_RSQRT"},
+  {                   BuiltinOperator_SELECT_V2,                    "OP_SELECT_V2"},
+  {                       BuiltinOperator_SHAPE,                        "OP_SHAPE"},
+  {                         BuiltinOperator_SIN,                          "OP_SIN"},
+  {                       BuiltinOperator_SLICE,                        "OP_SLICE"},
+  {                     BuiltinOperator_SOFTMAX,                      "OP_SOFTMAX"},
+  {           BuiltinOperator_SPACE_TO_BATCH_ND,            "OP_SPACE_TO_BATCH_ND"},
+  {              BuiltinOperator_SPACE_TO_DEPTH,               "OP_SPACE_TO_DEPTH"},
+  {                       BuiltinOperator_SPLIT,                        "OP_SPLIT"},
+  {                     BuiltinOperator_SPLIT_V,                      "OP_SPLIT_V"},
+  {                        BuiltinOperator_SQRT,                         "OP_SQRT"},
+  {                      BuiltinOperator_SQUARE,                       "OP_SQUARE"},
+  {          BuiltinOperator_SQUARED_DIFFERENCE,           "OP_SQUARED_DIFFERENCE"},
+  {                     BuiltinOperator_SQUEEZE,                      "OP_SQUEEZE"},
+  {               BuiltinOperator_STRIDED_SLICE,                "OP_STRIDED_SLICE"},
+  {                         BuiltinOperator_SUB,                          "OP_SUB"},
+  {                         BuiltinOperator_SUM,                          "OP_SUM"},
+  {                        BuiltinOperator_SVDF,                            "SVDF"},
+  {                        BuiltinOperator_TANH,                         "OP_TANH"},
+  {                   BuiltinOperator_TRANSPOSE,                    "OP_TRANSPOSE"},
+  {              BuiltinOperator_TRANSPOSE_CONV,               "OP_TRANSPOSE_CONV"},
+  {BuiltinOperator_UNIDIRECTIONAL_SEQUENCE_LSTM, "OP_UNIDIRECTIONAL_SEQUENCE_LSTM"},
+  {                      BuiltinOperator_UNPACK,                       "OP_UNPACK"},
+  {                  BuiltinOperator_VAR_HANDLE,                    "OP_VARHANDLE"},
+  {                       BuiltinOperator_WHILE,                        "OP_WHILE"},
+  {                  BuiltinOperator_ZEROS_LIKE,                   "OP_ZEROS_LIKE"},
+};
+
+constexpr custom_op_config_t CUSTOM_OP_CONFIGS[] = {
+  {             "CIRCULAR_BUFFER",        "OP_CIRULAR_BUFFER"},
+  {"TFLite_Detection_PostProcess", "OP_DETECTION_POSTPROCESS"},
+  {                     "ethos-u",               "OP_ETHOS_U"},
+};
+
 }  // namespace tflite
 
 namespace edgelab {
 
+    #if CONFIG_EL_ENGINE_PROFILER
+ProfilerTFLite::ProfilerTFLite() : _nodes(nullptr), _start_us(nullptr), _size(0), _next(0), _invocations(0) {}
+
+ProfilerTFLite::~ProfilerTFLite() { disable(); }
+
+el_err_code_t ProfilerTFLite::enable() {
+    if (!_nodes) {
+        _nodes    = static_cast<el_op_profile_t*>(el_malloc(CONFIG_EL_ENGINE_PROFILER_NODES_MAX * sizeof(*_nodes)));
+        _start_us = static_cast<uint64_t*>(el_malloc(CONFIG_EL_ENGINE_PROFILER_NODES_MAX * sizeof(*_start_us)));
+        if (!_nodes || !_start_us) [[unlikely]] {
+            disable();
+            return EL_ENOMEM;
+        }
+    }
+    reset();
+    return EL_OK;
+}
+
+void ProfilerTFLite::disable() {
+    if (_nodes) el_free(_nodes);
+    if (_start_us) el_free(_start_us);
+    _nodes    = nullptr;
+    _start_us = nullptr;
+    reset();
+}
+
+void ProfilerTFLite::reset() {
+    if (_nodes) std::memset(_nodes, 0, CONFIG_EL_ENGINE_PROFILER_NODES_MAX * sizeof(*_nodes));
+    _size        = 0;
+    _next        = 0;
+    _invocations = 0;
+}
+
+void ProfilerTFLite::end_invoke() {
+    if (!_nodes) return;
+    _size = EL_MAX(_size, _next);
+    ++_invocations;
+}
+
+// nodes past the table size (or all of them while disabled) get a handle that is ignored on end
+uint32_t ProfilerTFLite::BeginEvent(const char* tag) {
+    if (!_nodes || _next >= CONFIG_EL_ENGINE_PROFILER_NODES_MAX) return UINT32_MAX;
+    uint32_t handle    = _next++;
+    _nodes[handle].tag = tag;
+    _start_us[handle]  = el_get_time_us();
+    return handle;
+}
+
+void ProfilerTFLite::EndEvent(uint32_t event_handle) {
+    if (!_nodes || event_handle >= CONFIG_EL_ENGINE_PROFILER_NODES_MAX) return;
+    uint32_t elapsed = static_cast<uint32_t>(el_get_time_us() - _start_us[event_handle]);
+    auto&    node    = _nodes[event_handle];
+    node.count += 1;
+    node.total_us += elapsed;
+    node.max_us = EL_MAX(node.max_us, elapsed);
+}
+
+void ProfilerTFLite::get_profile(el_engine_profile_t* profile) const {
+    profile->nodes       = _nodes;
+    profile->size        = _size;
+    profile->invocations = _invocations;
+}
+    #endif
+
+    #if CONFIG_EL_ENGINE_MEMORY_PLAN_CACHE
+static constexpr uint32_t MEMORY_PLAN_MAGIC = 0x504C4E31;  // "PLN1", bump when the record layout changes
+
+MemoryPlannerTFLite::MemoryPlannerTFLite()
+    : _greedy(), _plan(nullptr), _hash(0), _count(0), _resolved(false), _dirty(false) {}
+
+MemoryPlannerTFLite::~MemoryPlannerTFLite() {
+    if (_plan) el_free(_plan);
+}
+
+TfLiteStatus MemoryPlannerTFLite::Init(unsigned char* scratch_buffer, int scratch_buffer_size) {
+    _hash     = 2166136261u;
+    _count    = 0;
+    _resolved = false;
+    _dirty    = false;
+    return _greedy.Init(scratch_buffer, scratch_buffer_size);
+}
+
+TfLiteStatus MemoryPlannerTFLite::AddBuffer(int size, int first_time_used, int last_time_used) {
+    return AddBuffer(size, first_time_used, last_time_used, -1);
+}
+
+// the greedy planner still records every buffer, it is cheap and lets a missing plan be computed as before
+TfLiteStatus MemoryPlannerTFLite::AddBuffer(int size, int first_time_used, int last_time_used, int offline_offset) {
+    auto status = offline_offset < 0 ? _greedy.AddBuffer(size, first_time_used, last_time_used)
+                                     : _greedy.AddBuffer(size, first_time_used, last_time_used, offline_offset);
+    if (status != kTfLiteOk) return status;
+
+    const int32_t fields[] = {size, first_time_used, last_time_used, offline_offset};
+    for (auto field : fields)
+        for (size_t i = 0; i < sizeof(field); ++i) {
+            _hash ^= static_cast<uint8_t>(static_cast<uint32_t>(field) >> (i * 8));
+            _hash *= 16777619u;
+        }
+    ++_count;
+    _resolved = false;
+    return kTfLiteOk;
+}
+
+size_t MemoryPlannerTFLite::GetMaximumMemorySize() {
+    resolve();
+    return _plan ? _plan->size : _greedy.GetMaximumMemorySize();
+}
+
+int MemoryPlannerTFLite::GetBufferCount() { return static_cast<int>(_count); }
+
+TfLiteStatus MemoryPlannerTFLite::GetOffsetForBuffer(int buffer_index, int* offset) {
+    resolve();
+    if (!_plan) return _greedy.GetOffsetForBuffer(buffer_index, offset);
+    if (buffer_index < 0 || static_cast<uint32_t>(buffer_index) >= _count) return kTfLiteError;
+    *offset = _plan->offsets()[buffer_index];
+    return kTfLiteOk;
+}
+
+void MemoryPlannerTFLite::PrintMemoryPlan() { _greedy.PrintMemoryPlan(); }
+
+// a plan takes the first free slot, a full cache evicts the one its hash maps to so flash use stays bounded
+void MemoryPlannerTFLite::commit() {
+    if (!_dirty || !_plan) return;
+    _dirty = false;
+
+    auto* storage = Storage::get_ptr();
+    if (!storage->is_ready()) return;
+    char   key[CONFIG_EL_STORAGE_KEY_SIZE_MAX];
+    size_t slot = _plan->hash % CONFIG_EL_ENGINE_MEMORY_PLAN_SLOTS;
+    for (size_t i = 0; i < CONFIG_EL_ENGINE_MEMORY_PLAN_SLOTS; ++i) {
+        plan_key(key, i);
+        if (!storage->contains(key)) {
+            slot = i;
+            break;
+        }
+    }
+
+    plan_key(key, slot);
+    if (storage->contains(key)) storage->erase(key);
+    types::el_storage_kv_t<uint8_t&> kv(key, *reinterpret_cast<uint8_t*>(_plan), plan_bytes(_plan->count));
+    if (!storage->emplace(kv)) {
+        EL_LOGD("memory plan %s not stored", key);
+    }
+}
+
+// the plan in memory serves preparing the same model twice in a row, storage serves every other load
+void MemoryPlannerTFLite::resolve() {
+    if (_resolved) return;
+    _resolved = true;
+    if (_plan && _plan->hash == _hash && _plan->count == _count) return;
+    if (load(_hash, _count)) return;
+
+    if (_plan) el_free(_plan);
+    _plan = static_cast<plan_t*>(el_malloc(plan_bytes(_count)));
+    if (!_plan) [[unlikely]]
+        return;
+    _plan->magic = MEMORY_PLAN_MAGIC;
+    _plan->hash  = _hash;
+    _plan->count = _count;
+    _plan->size  = static_cast<uint32_t>(_greedy.GetMaximumMemorySize());
+    for (uint32_t i = 0; i < _count; ++i) {
+        int offset = 0;
+        if (_greedy.GetOffsetForBuffer(static_cast<int>(i), &offset) != kTfLiteOk) {
+            el_free(_plan);
+            _plan = nullptr;
+            return;
+        }
+        _plan->offsets()[i] = offset;
+    }
+    _dirty = true;
+}
+
+void MemoryPlannerTFLite::plan_key(char* key, size_t slot) {
+    std::snprintf(key, CONFIG_EL_STORAGE_KEY_SIZE_MAX, "edgelab#plan#%u", static_cast<unsigned>(slot));
+}
+
+bool MemoryPlannerTFLite::load(uint32_t hash, uint32_t count) {
+    auto* storage = Storage::get_ptr();
+    if (!storage->is_ready()) return false;
+
+    auto* plan = static_cast<plan_t*>(el_malloc(plan_bytes(count)));
+    if (!plan) [[unlikely]]
+        return false;
+    char key[CONFIG_EL_STORAGE_KEY_SIZE_MAX];
+    bool valid = false;
+    for (size_t slot = 0; !valid && slot < CONFIG_EL_ENGINE_MEMORY_PLAN_SLOTS; ++slot) {
+        plan_key(key, slot);
+        if (storage->get_value_size(key) != plan_bytes(count)) continue;
+        std::memset(plan, 0, plan_bytes(count));
+        types::el_storage_kv_t<uint8_t&> kv(key, *reinterpret_cast<uint8_t*>(plan), plan_bytes(count));
+        valid = storage->get(kv) && plan->magic == MEMORY_PLAN_MAGIC && plan->hash == hash && plan->count == count;
+        for (uint32_t i = 0; valid && i < count; ++i)
+            valid = plan->offsets()[i] >= 0 && static_cast<uint32_t>(plan->offsets()[i]) <= plan->size;
+    }
+    if (!valid) {
+        el_free(plan);
+        return false;
+    }
+
+    if (_plan) el_free(_plan);
+    _plan = plan;
+    return true;
+}
+    #endif
+
 EngineTFLite::EngineTFLite() {
     interpreter      = nullptr;
     model            = nullptr;
     memory_pool.pool = nullptr;
     memory_pool.size = 0;
-    #ifdef CONFIG_EL_FILESYSTEM
+    resident_count   = 0;
+    arena_top        = 0;
+    arena_peak       = 0;
+    #if CONFIG_EL_ENGINE_ASYNC
+    async.callback = nullptr;
+    async.user     = nullptr;
+    async.ret      = EL_OK;
+    async.pending  = false;
+    async.stop     = false;
+    #else
+    async_ret = EL_OK;
+    #endif
+    #if defined(CONFIG_EL_FILESYSTEM) && !CONFIG_EL_PORTING_POSIX
     model_file = nullptr;
     #endif
 }
 
 EngineTFLite::~EngineTFLite() {
-    if (interpreter != nullptr) {
-        delete interpreter;
-        interpreter = nullptr;
+    wait();
+    #if CONFIG_EL_ENGINE_ASYNC
+    {
+        std::lock_guard<std::mutex> lock(async.mutex);
+        async.stop = true;
     }
+    async.wake.notify_one();
+    if (async.worker.joinable()) async.worker.join();
+    #endif
+    release_residents();
     if (memory_pool.pool != nullptr) {
         delete[] static_cast<uint8_t*>(memory_pool.pool);
         memory_pool.pool = nullptr;
     }
     #ifdef CONFIG_EL_FILESYSTEM
+        #if CONFIG_EL_PORTING_POSIX
+    for (const auto& file : model_files) munmap(file.data, file.size);
+    model_files.clear();
+        #else
     if (model_file != nullptr) {
-        delete model_file;
+        delete[] model_file;
         model_file = nullptr;
     }
+        #endif
     #endif
 }
 
@@ -363,48 +1149,313 @@ el_err_code_t EngineTFLite::init(size_t size) {
     if (pool == nullptr) {
         return EL_ENOMEM;
     }
+    wait();
+    release_residents();
     memory_pool.pool = pool;
     memory_pool.size = size;
+    arena_peak       = 0;
     return init();
 }
 
+// the prepared models stay resident as long as the engine is given the same memory pool, or the start of it
+// they all fit in, which is how a pool is trimmed to what the models need
 el_err_code_t EngineTFLite::init(void* pool, size_t size) {
+    wait();
+    if (pool != memory_pool.pool || size < arena_top) release_residents();
+    if (pool != memory_pool.pool) arena_peak = 0;
     memory_pool.pool = pool;
     memory_pool.size = size;
     return init();
 }
 
+    #if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+// the resolvers remove their virtual operator delete, so they live in storage of their own
+static tflite::ModelOpsResolver* create_model_ops_resolver(const tflite::Model* model) {
+    void* storage = el_malloc(sizeof(tflite::ModelOpsResolver));
+    if (storage == nullptr) {
+        return nullptr;
+    }
+    auto* resolver = new (storage) tflite::ModelOpsResolver();
+    if (resolver->AddModelOps(model) != kTfLiteOk) {
+        resolver->~ModelOpsResolver();
+        el_free(storage);
+        return nullptr;
+    }
+    return resolver;
+}
+
+static void destroy_model_ops_resolver(tflite::ModelOpsResolver* resolver) {
+    if (resolver == nullptr) {
+        return;
+    }
+    resolver->~ModelOpsResolver();
+    el_free(resolver);
+}
+    #endif
+
+void EngineTFLite::release_residents() {
+    for (size_t i = 0; i < resident_count; ++i) {
+        delete residents[i].interpreter;
+    #if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+        destroy_model_ops_resolver(residents[i].resolver);
+    #endif
+    }
+    resident_count = 0;
+    arena_top      = 0;
+    interpreter    = nullptr;
+    model          = nullptr;
+}
+
+static const tflite::MicroOpResolver& full_ops_resolver() {
+    static tflite::OpsResolver resolver;
+    return resolver;
+}
+
+el_err_code_t EngineTFLite::prepare(resident_t* resident, uint8_t* arena, size_t arena_size) {
+    #if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+    const tflite::MicroOpResolver& resolver =
+      resident->resolver ? static_cast<const tflite::MicroOpResolver&>(*resident->resolver) : full_ops_resolver();
+    #else
+    const tflite::MicroOpResolver& resolver = full_ops_resolver();
+    #endif
+
+    #if CONFIG_EL_ENGINE_PROFILER
+    tflite::MicroProfilerInterface* profiler_interface = &profiler;
+    #else
+    tflite::MicroProfilerInterface* profiler_interface = nullptr;
+    #endif
+
+    // a fresh slice starts zeroed, as the whole pool used to be on every load
+    std::memset(arena, 0, arena_size);
+    #if CONFIG_EL_ENGINE_MEMORY_PLAN_CACHE
+    // the allocator places itself in the arena, only the planner it plans with is ours
+    auto* allocator = tflite::MicroAllocator::Create(arena, arena_size, &planner);
+    if (allocator == nullptr) {
+        return EL_ELOG;
+    }
+    resident->interpreter =
+      new tflite::MicroInterpreter(resident->model, resolver, allocator, nullptr, profiler_interface);
+    #else
+    resident->interpreter =
+      new tflite::MicroInterpreter(resident->model, resolver, arena, arena_size, nullptr, profiler_interface);
+    #endif
+    if (resident->interpreter == nullptr) {
+        return EL_ENOMEM;
+    }
+    if (kTfLiteOk != resident->interpreter->AllocateTensors()) {
+        delete resident->interpreter;
+        resident->interpreter = nullptr;
+        return EL_ELOG;
+    }
+    #if CONFIG_EL_ENGINE_MEMORY_PLAN_CACHE
+    planner.commit();
+    #endif
+    resident->arena_size = arena_size;
+    return EL_OK;
+}
+
 el_err_code_t EngineTFLite::run() {
     EL_ASSERT(interpreter != nullptr);
 
-    if (kTfLiteOk != interpreter->Invoke()) {
+    #if CONFIG_EL_ENGINE_PROFILER
+    profiler.begin_invoke();
+    #endif
+    auto status = interpreter->Invoke();
+    #if CONFIG_EL_ENGINE_PROFILER
+    profiler.end_invoke();
+    #endif
+
+    if (kTfLiteOk != status) {
         return EL_ELOG;
     }
     return EL_OK;
 }
 
+    #if CONFIG_EL_ENGINE_ASYNC
+el_err_code_t EngineTFLite::run_async(void (*callback)(el_err_code_t ret, void* user), void* user) {
+    EL_ASSERT(interpreter != nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(async.mutex);
+        if (async.pending) {
+            return EL_EBUSY;
+        }
+        if (!async.worker.joinable()) async.worker = std::thread(&EngineTFLite::work, this);
+        async.callback = callback;
+        async.user     = user;
+        async.pending  = true;
+    }
+    async.wake.notify_one();
+    return EL_OK;
+}
+
+el_err_code_t EngineTFLite::wait() {
+    std::unique_lock<std::mutex> lock(async.mutex);
+    async.done.wait(lock, [this] { return !async.pending; });
+    return async.ret;
+}
+
+void EngineTFLite::work() {
+    std::unique_lock<std::mutex> lock(async.mutex);
+    for (;;) {
+        async.wake.wait(lock, [this] { return async.stop || async.pending; });
+        if (async.stop) return;
+        auto* callback = async.callback;
+        auto* user     = async.user;
+        lock.unlock();
+
+        el_err_code_t ret = run();
+
+        // the run is over before the callback hears of it, so the callback may read the outputs, wait() or start the
+        // next run without deadlocking on its own worker
+        lock.lock();
+        async.ret     = ret;
+        async.pending = false;
+        async.done.notify_all();
+        if (!callback) continue;
+        lock.unlock();
+        callback(ret, user);
+        lock.lock();
+    }
+}
+    #else
+// without a worker the run completes on the calling thread, so the caller still gets its callback and result
+el_err_code_t EngineTFLite::run_async(void (*callback)(el_err_code_t ret, void* user), void* user) {
+    async_ret = run();
+    if (callback) callback(async_ret, user);
+    return EL_OK;
+}
+
+el_err_code_t EngineTFLite::wait() { return async_ret; }
+    #endif
+
+// the leading dimension of the first input, every input and output holds that many items back to back
+size_t EngineTFLite::get_batch_size() const {
+    TfLiteTensor* input = interpreter->input_tensor(0);
+    if (input == nullptr || input->dims == nullptr || input->dims->size < 2 || input->dims->data[0] < 1) {
+        return 1;
+    }
+    return static_cast<size_t>(input->dims->data[0]);
+}
+
+el_err_code_t EngineTFLite::run_batch(const el_tensor_t* inputs, el_tensor_t* outputs, size_t count) {
+    EL_ASSERT(interpreter != nullptr);
+
+    wait();
+
+    // everything is checked up front so a bad item does not leave the batch half done
+    size_t batch = get_batch_size();
+    for (size_t i = 0; i < count; ++i) {
+        if (inputs[i].index >= interpreter->inputs().size() || outputs[i].index >= interpreter->outputs().size()) {
+            return EL_EINVAL;
+        }
+        TfLiteTensor* input  = interpreter->input_tensor(inputs[i].index);
+        TfLiteTensor* output = interpreter->output_tensor(outputs[i].index);
+        if (input == nullptr || output == nullptr || input->bytes % batch || output->bytes % batch) {
+            return EL_EINVAL;
+        }
+        if (inputs[i].size != input->bytes / batch || outputs[i].size != output->bytes / batch) {
+            return EL_EINVAL;
+        }
+    }
+
+    // the slots a short last chunk leaves empty still hold items of the chunk before, their results are dropped
+    for (size_t first = 0; first < count; first += batch) {
+        size_t last = EL_MIN(first + batch, count);
+        for (size_t i = first; i < last; ++i) {
+            TfLiteTensor* input = interpreter->input_tensor(inputs[i].index);
+            memcpy(static_cast<uint8_t*>(input->data.data) + (i - first) * inputs[i].size,
+                   inputs[i].data,
+                   inputs[i].size);
+        }
+
+        el_err_code_t ret = run();
+        if (ret != EL_OK) {
+            return ret;
+        }
+
+        for (size_t i = first; i < last; ++i) {
+            TfLiteTensor* output = interpreter->output_tensor(outputs[i].index);
+            memcpy(outputs[i].data,
+                   static_cast<const uint8_t*>(output->data.data) + (i - first) * outputs[i].size,
+                   outputs[i].size);
+        }
+    }
+
+    return EL_OK;
+}
+
 el_err_code_t EngineTFLite::load_model(const void* model_data, size_t model_size) {
-    model = tflite::GetModel(model_data);
-    if (model == nullptr) {
+    // the interpreter of a run still in flight may be the one about to be dropped
+    wait();
+
+    #if CONFIG_EL_ENGINE_PROFILER
+    // timings of the previous model do not apply to the new graph
+    profiler.reset();
+    #endif
+
+    // switching back to a resident model only swaps the interpreter
+    for (size_t i = 0; i < resident_count; ++i) {
+        if (residents[i].model_data == model_data && residents[i].model_size == model_size) {
+            interpreter = residents[i].interpreter;
+            model       = residents[i].model;
+            return EL_OK;
+        }
+    }
+
+    interpreter       = nullptr;
+    model             = nullptr;
+    const auto* graph = tflite::GetModel(model_data);
+    if (graph == nullptr) {
         return EL_EINVAL;
     }
-    static tflite::OpsResolver resolver;
-    #if EL_DEALLOCATE_USED_INTERPRETER
-    if (interpreter) {
-        delete interpreter;
-        interpreter = nullptr;
+
+    // when the slots or the rest of the pool run out, every resident model is dropped and the pool starts over
+    auto* pool = static_cast<uint8_t*>(memory_pool.pool);
+    if (resident_count >= CONFIG_EL_ENGINE_RESIDENT_MODELS_MAX) release_residents();
+
+    resident_t resident{model_data, model_size, graph, nullptr, 0};
+    #if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+    // only the operators the model refers to are registered, falling back to every compiled in one when the model
+    // uses more than the resolver holds or one that is not compiled in (preparing reports the latter)
+    resident.resolver = create_model_ops_resolver(graph);
+    #endif
+
+    el_err_code_t ret = prepare(&resident, pool + arena_top, memory_pool.size - arena_top);
+    if (ret == EL_ELOG && arena_top) {
+        release_residents();
+        ret = prepare(&resident, pool, memory_pool.size);
     }
+    if (ret != EL_OK) {
+    #if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+        destroy_model_ops_resolver(resident.resolver);
     #endif
-    interpreter =
-      new tflite::MicroInterpreter(model, resolver, static_cast<uint8_t*>(memory_pool.pool), memory_pool.size);
-    if (interpreter == nullptr) {
-        return EL_ENOMEM;
+        return ret;
     }
-    if (kTfLiteOk != interpreter->AllocateTensors()) {
-        delete interpreter;
-        interpreter = nullptr;
-        return EL_ELOG;
+
+    // prepare again in a slice of the size the model actually used so the next one fits behind it, keeping the
+    // first interpreter if the tight fit fails
+    size_t used = (resident.interpreter->arena_used_bytes() + 15) & ~static_cast<size_t>(15);
+    if (used < resident.arena_size) {
+        resident_t tight{resident};
+        delete resident.interpreter;
+        if (prepare(&tight, pool + arena_top, used) == EL_OK)
+            resident = tight;
+        else
+            ret = prepare(&resident, pool + arena_top, resident.arena_size);
     }
+    if (ret != EL_OK) {
+    #if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+        destroy_model_ops_resolver(resident.resolver);
+    #endif
+        return ret;
+    }
+
+    residents[resident_count++] = resident;
+    arena_top += resident.arena_size;
+    arena_peak  = EL_MAX(arena_peak, arena_top);
+    interpreter = resident.interpreter;
+    model       = resident.model;
     return EL_OK;
 }
 
@@ -525,7 +1576,113 @@ el_quant_param_t EngineTFLite::get_output_quant_param(size_t index) const {
     return quant_param;
 }
 
+size_t EngineTFLite::get_input_size(size_t index) const {
+    EL_ASSERT(interpreter != nullptr);
+
+    if (index >= interpreter->inputs().size()) {
+        return 0;
+    }
+    TfLiteTensor* input = interpreter->input_tensor(index);
+    if (input == nullptr) {
+        return 0;
+    }
+    return input->bytes;
+}
+
+size_t EngineTFLite::get_output_size(size_t index) const {
+    EL_ASSERT(interpreter != nullptr);
+
+    if (index >= interpreter->outputs().size()) {
+        return 0;
+    }
+    TfLiteTensor* output = interpreter->output_tensor(index);
+    if (output == nullptr) {
+        return 0;
+    }
+    return output->bytes;
+}
+
+el_err_code_t EngineTFLite::set_profiling(bool enable) {
+    #if CONFIG_EL_ENGINE_PROFILER
+    wait();
+    if (!enable) {
+        profiler.disable();
+        return EL_OK;
+    }
+    return profiler.enable();
+    #else
+    (void)enable;
+    return EL_ENOTSUP;
+    #endif
+}
+
+el_err_code_t EngineTFLite::get_profile(el_engine_profile_t* profile) const {
+    #if CONFIG_EL_ENGINE_PROFILER
+        #if CONFIG_EL_ENGINE_ASYNC
+    // the worker writes the node table while a run is in flight
+    {
+        std::unique_lock<std::mutex> lock(async.mutex);
+        async.done.wait(lock, [this] { return !async.pending; });
+    }
+        #endif
+    profiler.get_profile(profile);
+    return EL_OK;
+    #else
+    *profile = el_engine_profile_t{};
+    return EL_ENOTSUP;
+    #endif
+}
+
+el_err_code_t EngineTFLite::get_memory_usage(el_engine_memory_t* memory) const {
+    memory->size  = memory_pool.size;
+    memory->used  = arena_top;
+    memory->model = interpreter ? interpreter->arena_used_bytes() : 0;
+    memory->peak  = arena_peak;
+    return EL_OK;
+}
+
     #ifdef CONFIG_EL_FILESYSTEM
+        #if CONFIG_EL_PORTING_POSIX
+// the interpreter reads the model straight from the page cache, no heap copy is made and the pages are shared with
+// other processes mapping the same file, a file replaced since it was mapped gets a new mapping
+el_err_code_t EngineTFLite::load_model(const char* model_path) {
+    struct stat st;
+    if (stat(model_path, &st) != 0 || st.st_size <= 0) {
+        return EL_ELOG;
+    }
+    auto it = std::find_if(model_files.begin(), model_files.end(), [&](const model_file_t& file) {
+        return file.path == model_path && file.inode == st.st_ino && file.mtime == st.st_mtime &&
+               file.size == static_cast<size_t>(st.st_size);
+    });
+    bool mapped = it == model_files.end();
+
+    if (mapped) {
+        int fd = open(model_path, O_RDONLY);
+        if (fd < 0) {
+            return EL_ELOG;
+        }
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            return EL_ENOMEM;
+        }
+        it = model_files.insert(model_files.end(),
+                                {model_path,
+                                 static_cast<uint64_t>(st.st_ino),
+                                 static_cast<int64_t>(st.st_mtime),
+                                 data,
+                                 static_cast<size_t>(st.st_size)});
+    }
+
+    el_err_code_t ret = load_model(it->data, it->size);
+    if (ret != EL_OK && mapped) {
+        munmap(it->data, it->size);
+        model_files.erase(it);
+    }
+
+    return ret;
+}
+        #else
 el_err_code_t EngineTFLite::load_model(const char* model_path) {
     el_err_code_t ret  = EL_OK;
     size_t        size = 0;
@@ -539,18 +1696,85 @@ el_err_code_t EngineTFLite::load_model(const char* model_path) {
         return EL_ENOMEM;
     }
     file.seekg(0, std::ios::beg);
-    file.read(static_cast<char*>(model_file), size);
+    file.read(model_file, size);
     file.close();
     ret = load_model(model_file, size);
     if (ret != EL_OK) {
-        delete model_file;
+        delete[] model_file;
         model_file = nullptr;
     }
 
     return ret;
 }
+        #endif
     #endif
 
+el_err_code_t el_tflite_ops_config(const void* model_data,
+                                   size_t      model_size,
+                                   void (*sink)(const char* line, void* user),
+                                   void* user) {
+    // the operator list is walked as is, so anything but a well formed model is turned away before
+    if (model_data == nullptr || model_size == 0) {
+        return EL_EINVAL;
+    }
+    flatbuffers::Verifier verifier(static_cast<const uint8_t*>(model_data), model_size);
+    if (!tflite::VerifyModelBuffer(verifier)) {
+        return EL_EINVAL;
+    }
+    const auto* model = tflite::GetModel(model_data);
+    if (model == nullptr || model->operator_codes() == nullptr) {
+        return EL_EINVAL;
+    }
+    const auto* codes = model->operator_codes();
+
+    auto custom_name = [](const tflite::OperatorCode* code) {
+        return code->custom_code() ? code->custom_code()->c_str() : "";
+    };
+    auto emit = [sink, user](const char* line) {
+        if (sink)
+            sink(line, user);
+        else
+            el_printf("%s\n", line);
+    };
+
+    el_err_code_t ret = EL_OK;
+    char          line[128];
+    emit("#define CONFIG_EL_TFLITE");
+    for (size_t i = 0; i < codes->size(); ++i) {
+        auto        builtin = tflite::GetBuiltinCode(codes->Get(i));
+        const char* custom  = custom_name(codes->Get(i));
+
+        // an operator listed once per version is written once
+        bool seen = false;
+        for (size_t j = 0; j < i; ++j)
+            if (tflite::GetBuiltinCode(codes->Get(j)) == builtin && std::strcmp(custom_name(codes->Get(j)), custom) == 0)
+                seen = true;
+        if (seen) continue;
+
+        const char* define = nullptr;
+        if (builtin == tflite::BuiltinOperator_CUSTOM) {
+            for (const auto& op : tflite::CUSTOM_OP_CONFIGS)
+                if (std::strcmp(op.name, custom) == 0) define = op.define;
+        } else {
+            for (const auto& op : tflite::BUILTIN_OP_CONFIGS)
+                if (op.builtin == builtin) define = op.define;
+        }
+
+        if (define)
+            std::snprintf(line, sizeof(line), "#define CONFIG_EL_TFLITE_%s", define);
+        else {
+            std::snprintf(line,
+                          sizeof(line),
+                          "// %s is not supported by the engine",
+                          builtin == tflite::BuiltinOperator_CUSTOM ? custom : tflite::EnumNameBuiltinOperator(builtin));
+            ret = EL_ENOTSUP;
+        }
+        emit(line);
+    }
+
+    return ret;
+}
+
 }  // namespace edgelab
 
 #endif
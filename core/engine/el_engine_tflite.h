@@ -28,17 +28,32 @@
 
 #include <tensorflow/lite/c/common.h>
 #include <tensorflow/lite/micro/compatibility.h>
+#include <tensorflow/lite/micro/memory_planner/greedy_memory_planner.h>
+#include <tensorflow/lite/micro/micro_allocator.h>
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
+#include <tensorflow/lite/micro/micro_profiler_interface.h>
 #include <tensorflow/lite/micro/system_setup.h>
 #include <tensorflow/lite/schema/schema_generated.h>
+#include <tensorflow/lite/schema/schema_utils.h>
 
 #include <cstddef>
 #include <cstdint>
 
+#if defined(CONFIG_EL_FILESYSTEM) && CONFIG_EL_PORTING_POSIX
+    #include <string>
+    #include <vector>
+#endif
+
 #include "core/el_types.h"
 #include "el_engine_base.h"
 
+#if CONFIG_EL_ENGINE_ASYNC
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+#endif
+
 #define TF_LITE_SATTIC_MEMORY
 
 namespace tflite {
@@ -347,10 +362,109 @@ class OpsResolver : public MicroMutableOpResolver<OpsCount::OpsTail - OpsCount::
     TF_LITE_REMOVE_VIRTUAL_DELETE
 };
 
+#if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+// registers only the operators a model refers to, out of those compiled in
+class ModelOpsResolver : public MicroMutableOpResolver<CONFIG_EL_TFLITE_MODEL_OPS_MAX> {
+   public:
+    TfLiteStatus AddModelOps(const Model* model);
+
+   private:
+    TfLiteStatus AddOp(const OperatorCode* code);
+};
+#endif
+
 }  // namespace tflite
 
 namespace edgelab {
 
+// writes the CONFIG_EL_TFLITE_OP_* defines of the operators a model uses one line at a time, to trim a build down
+// to its models, operators the engine cannot register are written as comments and make it return EL_ENOTSUP, a
+// buffer that does not verify as a model of model_size bytes returns EL_EINVAL
+el_err_code_t el_tflite_ops_config(const void* model_data,
+                                   size_t      model_size,
+                                   void (*sink)(const char* line, void* user) = nullptr,
+                                   void* user                                   = nullptr);
+
+#if CONFIG_EL_ENGINE_PROFILER
+// the interpreter opens one event per node it runs, events are numbered by their order within an invocation so
+// each node keeps its own slot across invocations
+class ProfilerTFLite final : public tflite::MicroProfilerInterface {
+   public:
+    ProfilerTFLite();
+    ~ProfilerTFLite() override;
+
+    el_err_code_t enable();
+    void          disable();
+    void          reset();
+
+    void begin_invoke() { _next = 0; }
+    void end_invoke();
+
+    uint32_t BeginEvent(const char* tag) override;
+    void     EndEvent(uint32_t event_handle) override;
+
+    void get_profile(el_engine_profile_t* profile) const;
+
+   private:
+    el_op_profile_t* _nodes;
+    uint64_t*        _start_us;
+    size_t           _size;
+    size_t           _next;
+    uint32_t         _invocations;
+
+    TF_LITE_REMOVE_VIRTUAL_DELETE
+};
+#endif
+
+#if CONFIG_EL_ENGINE_MEMORY_PLAN_CACHE
+// the arena layout is a function of the buffer requirements alone, so they are hashed as the allocator adds them
+// and a plan kept in storage under that hash is handed out instead of running the greedy planner again, the plans
+// share a fixed set of storage slots so repeatedly flashing new models does not grow the records without bound
+class MemoryPlannerTFLite final : public tflite::MicroMemoryPlanner {
+   public:
+    MemoryPlannerTFLite();
+    ~MemoryPlannerTFLite() override;
+
+    TfLiteStatus Init(unsigned char* scratch_buffer, int scratch_buffer_size) override;
+    TfLiteStatus AddBuffer(int size, int first_time_used, int last_time_used) override;
+    TfLiteStatus AddBuffer(int size, int first_time_used, int last_time_used, int offline_offset) override;
+    size_t       GetMaximumMemorySize() override;
+    int          GetBufferCount() override;
+    TfLiteStatus GetOffsetForBuffer(int buffer_index, int* offset) override;
+    void         PrintMemoryPlan() override;
+    bool         preserves_all_tensors() const override { return false; }
+
+    // writes a freshly computed plan to storage, called once the tensors it was made for are allocated
+    void commit();
+
+   private:
+    struct plan_t {
+        uint32_t magic;
+        uint32_t hash;
+        uint32_t count;
+        uint32_t size;
+
+        int32_t* offsets() { return reinterpret_cast<int32_t*>(this + 1); }  // count of them follow the header
+    };
+
+    static size_t plan_bytes(uint32_t count) { return sizeof(plan_t) + count * sizeof(int32_t); }
+
+    static void plan_key(char* key, size_t slot);
+
+    void resolve();
+    bool load(uint32_t hash, uint32_t count);
+
+    tflite::GreedyMemoryPlanner _greedy;
+    plan_t*                     _plan;  // the last plan resolved, reused while the requirements stay the same
+    uint32_t                    _hash;
+    uint32_t                    _count;
+    bool                        _resolved;
+    bool                        _dirty;
+
+    TF_LITE_REMOVE_VIRTUAL_DELETE
+};
+#endif
+
 class EngineTFLite final : public base::Engine {
    public:
     EngineTFLite();
@@ -361,6 +475,9 @@ class EngineTFLite final : public base::Engine {
     el_err_code_t init(void* pool, size_t size) override;
 
     el_err_code_t run() override;
+    el_err_code_t run_async(void (*callback)(el_err_code_t ret, void* user) = nullptr, void* user = nullptr) override;
+    el_err_code_t wait() override;
+    el_err_code_t run_batch(const el_tensor_t* inputs, el_tensor_t* outputs, size_t count) override;
 
 #ifdef CONFIG_EL_FILESYSTEM
     el_err_code_t load_model(const char* model_path) override;
@@ -378,6 +495,14 @@ class EngineTFLite final : public base::Engine {
     el_quant_param_t get_input_quant_param(size_t index) const override;
     el_quant_param_t get_output_quant_param(size_t index) const override;
 
+    size_t get_input_size(size_t index) const override;
+    size_t get_output_size(size_t index) const override;
+
+    el_err_code_t set_profiling(bool enable) override;
+    el_err_code_t get_profile(el_engine_profile_t* profile) const override;
+
+    el_err_code_t get_memory_usage(el_engine_memory_t* memory) const override;
+
 #ifdef CONFIG_EL_INFERENCER_TENSOR_NAME
     size_t           get_input_index(const char* input_name) const override;
     size_t           get_output_index(const char* output_name) const override;
@@ -391,12 +516,74 @@ class EngineTFLite final : public base::Engine {
 #endif
 
    private:
+    // a model prepared in its own slice of the memory pool, slices are handed out back to back from the start
+    struct resident_t {
+        const void*               model_data;
+        size_t                    model_size;
+        const tflite::Model*      model;
+        tflite::MicroInterpreter* interpreter;
+        size_t                    arena_size;
+#if CONFIG_EL_TFLITE_MODEL_OPS_MAX
+        tflite::ModelOpsResolver* resolver;  // nullptr when the model needs the full set
+#endif
+    };
+
+    el_err_code_t prepare(resident_t* resident, uint8_t* arena, size_t arena_size);
+    size_t        get_batch_size() const;
+    void          release_residents();
+
     tflite::MicroInterpreter* interpreter;
     const tflite::Model*      model;
     el_memory_pool_t          memory_pool;
 
+    resident_t residents[CONFIG_EL_ENGINE_RESIDENT_MODELS_MAX];
+    size_t     resident_count;
+    size_t     arena_top;
+    size_t     arena_peak;
+
+#if CONFIG_EL_ENGINE_PROFILER
+    ProfilerTFLite profiler;
+#endif
+
+#if CONFIG_EL_ENGINE_MEMORY_PLAN_CACHE
+    MemoryPlannerTFLite planner;
+#endif
+
+#if CONFIG_EL_ENGINE_ASYNC
+    // a single worker started by the first asynchronous run, one run is in flight at a time, const readers of what a
+    // run writes wait on it as well
+    mutable struct async_t {
+        std::mutex              mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::thread             worker;
+        void (*callback)(el_err_code_t ret, void* user);
+        void*         user;
+        el_err_code_t ret;
+        bool          pending;
+        bool          stop;
+    } async;
+
+    void work();
+#else
+    el_err_code_t async_ret;
+#endif
+
 #ifdef CONFIG_EL_FILESYSTEM
-    const char* model_file;
+    #if CONFIG_EL_PORTING_POSIX
+    // read only mappings of the model files, kept until the engine goes away as resident models point into them
+    struct model_file_t {
+        std::string path;
+        uint64_t    inode;
+        int64_t     mtime;
+        void*       data;
+        size_t      size;
+    };
+
+    std::vector<model_file_t> model_files;
+    #else
+    char* model_file;
+    #endif
 #endif
 };
 
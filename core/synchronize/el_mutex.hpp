@@ -35,6 +35,9 @@ class Mutex {
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
     Mutex() noexcept : _lock(xSemaphoreCreateCounting(1, 1)) {}
     ~Mutex() noexcept { vSemaphoreDelete(_lock); }
+#elif CONFIG_EL_HAS_PTHREAD_SUPPORT
+    Mutex() noexcept { pthread_mutex_init(&_lock, nullptr); }
+    ~Mutex() noexcept { pthread_mutex_destroy(&_lock); }
 #else
     Mutex() noexcept  = default;
     ~Mutex() noexcept = default;
@@ -43,18 +46,24 @@ class Mutex {
     inline void lock() const {
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
         xSemaphoreTake(_lock, portMAX_DELAY);
+#elif CONFIG_EL_HAS_PTHREAD_SUPPORT
+        pthread_mutex_lock(&_lock);
 #endif
     }
 
     inline void unlock() const {
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
         xSemaphoreGive(_lock);
+#elif CONFIG_EL_HAS_PTHREAD_SUPPORT
+        pthread_mutex_unlock(&_lock);
 #endif
     }
 
    private:
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
     mutable SemaphoreHandle_t _lock;
+#elif CONFIG_EL_HAS_PTHREAD_SUPPORT
+    mutable pthread_mutex_t _lock;
 #endif
 };
 
@@ -27,11 +27,19 @@
 
 #include <memory>
 
+#if CONFIG_EL_CV_THREADS > 1
+    #include <condition_variable>
+    #include <functional>
+    #include <mutex>
+    #include <thread>
+#endif
+
 #include "core/el_common.h"
 #include "core/el_compiler.h"
 #include "core/el_config_internal.h"
 #include "core/el_debug.h"
 #include "core/el_types.h"
+#include "el_jpeg.h"
 
 #if CONFIG_EL_LIB_JPEGENC
     #include "third_party/JPEGENC/JPEGENC.h"
@@ -53,6 +61,22 @@ const static uint8_t RGB565_TO_RGB888_LOOKUP_TABLE_6[] = {
   0xC2, 0xC6, 0xCA, 0xCE, 0xD2, 0xD7, 0xDB, 0xDF, 0xE3, 0xE7, 0xEB, 0xEF, 0xF3, 0xF7, 0xFB, 0xFF,
 };
 
+constexpr el_img_lut_t make_identity_lut() {
+    el_img_lut_t lut{};
+    for (size_t c = 0; c < 3; ++c)
+        for (size_t i = 0; i < 256; ++i) lut.table[c][i] = static_cast<uint8_t>(i);
+    return lut;
+}
+
+const static el_img_lut_t IDENTITY_LOOKUP_TABLE = make_identity_lut();
+
+// edge length in pixels of the tiles transposing rotations are processed in, 16 lines of 16 pixels per tile keep
+// both the source rows and the destination columns touched within the cache (or TCM)
+constexpr uint16_t ROTATE_TILE_SIZE = 16;
+
+// gray the letterbox pad is filled with before the input lut is applied
+constexpr uint8_t LETTERBOX_PAD_VALUE = 114;
+
 }  // namespace constants
 
 namespace types {
@@ -68,67 +92,317 @@ typedef struct EL_ATTR_PACKED b24_t {
     uint8_t b16_24;
 } b24_t;
 
+// sampling coefficients of a destination column (or row)
+typedef struct resize_coeff_t {
+    uint16_t index;  // first source pixel
+    uint16_t span;   // bilinear: offset of the second tap (0 or 1), area: box size
+    uint32_t coeff;  // bilinear: Q8 weight of the second tap, area: Q16 reciprocal of the box size
+} resize_coeff_t;
+
 }  // namespace types
 
 using namespace constants;
 using namespace types;
 
-// TODO: need to be optimized
-EL_ATTR_WEAK void yuv422p_to_rgb(const el_img_t* src, el_img_t* dst) {
-    int32_t  y;
-    int32_t  cr;
-    int32_t  cb;
-    int32_t  r, g, b;
-    uint32_t init_index, cbcr_index, index;
-    uint32_t u_chunk = src->width * src->height;
-    uint32_t v_chunk = src->width * src->height + src->width * src->height / 2;
-    float    beta_h = (float)src->height / dst->height, beta_w = (float)src->width / dst->width;
-
-    EL_ASSERT(src->format == EL_PIXEL_FORMAT_YUV422);
-
-    for (int i = 0; i < dst->height; i++) {
-        for (int j = 0; j < dst->width; j++) {
-            int tmph = i * beta_h, tmpw = beta_w * j;
-            index      = i * dst->width + j;
-            init_index = tmph * src->width + tmpw;
-            cbcr_index = init_index % 2 ? init_index - 1 : init_index;
-
-            y  = src->data[init_index];
-            cb = src->data[u_chunk + cbcr_index / 2];
-            cr = src->data[v_chunk + cbcr_index / 2];
-            r  = (int32_t)(y + (14065 * (cr - 128)) / 10000);
-            g  = (int32_t)(y - (3455 * (cb - 128)) / 10000 - (7169 * (cr - 128)) / 10000);
-            b  = (int32_t)(y + (17790 * (cb - 128)) / 10000);
-
-            switch (dst->rotate) {
-            case EL_PIXEL_ROTATE_90:
-                index = (index % dst->width) * (dst->height) + (dst->height - 1 - index / dst->width);
-                break;
-            case EL_PIXEL_ROTATE_180:
-                index = (dst->width - 1 - index % dst->width) + (dst->height - 1 - index / dst->width) * (dst->width);
-                break;
-            case EL_PIXEL_ROTATE_270:
-                index = (dst->width - 1 - index % dst->width) * (dst->height) + index / dst->width;
-                break;
-            default:
-                break;
-            }
-            if (dst->format == EL_PIXEL_FORMAT_GRAYSCALE) {
-                uint8_t gray     = (r * 299 + g * 587 + b * 114) / 1000;
-                dst->data[index] = (uint8_t)EL_CLIP(gray, 0, 255);
-            } else if (dst->format == EL_PIXEL_FORMAT_RGB565) {
-                dst->data[index * 2 + 0] = (r & 0xF8) | (g >> 5);
-                dst->data[index * 2 + 1] = ((g << 3) & 0xE0) | (b >> 3);
-            } else if (dst->format == EL_PIXEL_FORMAT_RGB888) {
-                dst->data[index * 3 + 0] = (uint8_t)EL_CLIP(r, 0, 255);
-                dst->data[index * 3 + 1] = (uint8_t)EL_CLIP(g, 0, 255);
-                dst->data[index * 3 + 2] = (uint8_t)EL_CLIP(b, 0, 255);
-            }
+uint8_t el_img_bpp(el_pixel_format_t format) {
+    switch (format) {
+    case EL_PIXEL_FORMAT_RGB888:
+        return 3;
+    case EL_PIXEL_FORMAT_RGB565:
+    case EL_PIXEL_FORMAT_YUYV:
+    case EL_PIXEL_FORMAT_UYVY:
+        return 2;
+    case EL_PIXEL_FORMAT_GRAYSCALE:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// width in pixels of the rows stored in memory
+static inline uint16_t stored_width(const el_img_t* img) {
+    return img->rotate == EL_PIXEL_ROTATE_90 || img->rotate == EL_PIXEL_ROTATE_270 ? img->height : img->width;
+}
+
+// true if the rows of img follow each other without padding
+static inline bool is_packed(const el_img_t* img) {
+    return !img->pitch || img->pitch == static_cast<size_t>(stored_width(img)) * el_img_bpp(img->format);
+}
+
+size_t el_img_pitch(const el_img_t* img) {
+    return img->pitch ? img->pitch : static_cast<size_t>(stored_width(img)) * el_img_bpp(img->format);
+}
+
+el_err_code_t el_img_view(const el_img_t* img, uint16_t x, uint16_t y, uint16_t w, uint16_t h, el_img_t* view) {
+    if (!img || !img->data || !view || !w || !h) [[unlikely]]
+        return EL_EINVAL;
+
+    uint8_t bpp = el_img_bpp(img->format);
+    if (!bpp) [[unlikely]]
+        return EL_ENOTSUP;
+
+    bool     transposed = img->rotate == EL_PIXEL_ROTATE_90 || img->rotate == EL_PIXEL_ROTATE_270;
+    uint16_t iw         = stored_width(img);
+    uint16_t ih         = transposed ? img->width : img->height;
+    if (x + w > iw || y + h > ih) [[unlikely]]
+        return EL_EINVAL;
+
+    size_t pitch = el_img_pitch(img);
+
+    view->data   = img->data + y * pitch + x * bpp;
+    view->size   = (h - 1) * pitch + w * bpp;
+    view->width  = transposed ? h : w;
+    view->height = transposed ? w : h;
+    view->format = img->format;
+    view->rotate = img->rotate;
+    view->pitch  = static_cast<uint32_t>(pitch);
+
+    return EL_OK;
+}
+
+void el_img_fit_map(const el_img_t* src, const el_img_t* dst, el_pixel_fit_t fit, el_img_map_t* map) {
+    uint32_t sw = src->width;
+    uint32_t sh = src->height;
+    uint16_t dw = dst->width;
+    uint16_t dh = dst->height;
+    uint16_t w  = dw;
+    uint16_t h  = dh;
+
+    // the longer side (relative to the destination aspect) spans the destination, the other one is rounded
+    if (fit == EL_PIXEL_FIT_LETTERBOX) {
+        if (sw * dh >= sh * dw)
+            h = EL_CLIP((sh * dw + (sw >> 1)) / sw, 1u, static_cast<uint32_t>(dh));
+        else
+            w = EL_CLIP((sw * dh + (sh >> 1)) / sh, 1u, static_cast<uint32_t>(dw));
+    }
+
+    map->x_scale  = static_cast<float>(sw) / static_cast<float>(w);
+    map->y_scale  = static_cast<float>(sh) / static_cast<float>(h);
+    map->x_offset = (dw - w) >> 1;
+    map->y_offset = (dh - h) >> 1;
+    map->w        = w;
+    map->h        = h;
+}
+
+#if CONFIG_EL_CV_SIMD
+
+namespace simd {
+
+// 128-bit vectors map to SSE, NEON and Helium registers, wider ones are split by the compiler
+typedef uint8_t  v16u8_t __attribute__((vector_size(16)));
+typedef uint16_t v8u16_t __attribute__((vector_size(16)));
+typedef uint32_t v8u32_t __attribute__((vector_size(32)));
+
+typedef void (*span_fn_t)(const uint8_t* s, uint8_t* d, size_t n);
+
+// bit-exact with RGB565_TO_RGB888_LOOKUP_TABLE_5/6, round(x * 255 / 31) and round(x * 255 / 63)
+EL_ATTR_ALWAYS_INLINE inline v8u16_t expand_5(v8u16_t x) { return (x * 527 + 23) >> 6; }
+EL_ATTR_ALWAYS_INLINE inline v8u16_t expand_6(v8u16_t x) { return (x * 259 + 33) >> 6; }
+
+// (r * 299 + g * 587 + b * 114) / 1000, the division is exact for every sum of 8-bit channels
+EL_ATTR_ALWAYS_INLINE inline void luma(const v8u32_t& r, const v8u32_t& g, const v8u32_t& b, uint8_t* d) {
+    v8u32_t y = (((r * 299 + g * 587 + b * 114) >> 3) * 33555) >> 22;
+    for (uint8_t k = 0; k < 8; ++k) d[k] = y[k];
+}
+
+EL_ATTR_ALWAYS_INLINE inline void unpack_rgb565(const uint8_t* s, v8u16_t& r, v8u16_t& g, v8u16_t& b) {
+    v8u16_t p;
+    memcpy(&p, s, sizeof(p));
+    // byte 0 is RRRRRGGG and byte 1 is GGGBBBBB
+    r = expand_5((p & 0xF8) >> 3);
+    g = expand_6(((p & 0x07) << 3) | (p >> 13));
+    b = expand_5((p >> 8) & 0x1F);
+}
+
+static void rgb565_to_rgb888(const uint8_t* s, uint8_t* d, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, s += 16, d += 24) {
+        v8u16_t r, g, b;
+        unpack_rgb565(s, r, g, b);
+        for (uint8_t k = 0; k < 8; ++k) {
+            d[k * 3]     = r[k];
+            d[k * 3 + 1] = g[k];
+            d[k * 3 + 2] = b[k];
         }
     }
+    for (; i < n; ++i, s += 2, d += 3) {
+        d[0] = RGB565_TO_RGB888_LOOKUP_TABLE_5[(s[0] & 0xF8) >> 3];
+        d[1] = RGB565_TO_RGB888_LOOKUP_TABLE_6[((s[0] & 0x07) << 3) | ((s[1] & 0xE0) >> 5)];
+        d[2] = RGB565_TO_RGB888_LOOKUP_TABLE_5[s[1] & 0x1F];
+    }
+}
+
+static void rgb565_to_gray(const uint8_t* s, uint8_t* d, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, s += 16, d += 8) {
+        v8u16_t r, g, b;
+        unpack_rgb565(s, r, g, b);
+        luma(__builtin_convertvector(r, v8u32_t),
+             __builtin_convertvector(g, v8u32_t),
+             __builtin_convertvector(b, v8u32_t),
+             d);
+    }
+    for (; i < n; ++i, s += 2) {
+        uint8_t r = RGB565_TO_RGB888_LOOKUP_TABLE_5[(s[0] & 0xF8) >> 3];
+        uint8_t g = RGB565_TO_RGB888_LOOKUP_TABLE_6[((s[0] & 0x07) << 3) | ((s[1] & 0xE0) >> 5)];
+        uint8_t b = RGB565_TO_RGB888_LOOKUP_TABLE_5[s[1] & 0x1F];
+        *d++      = (r * 299 + g * 587 + b * 114) / 1000;
+    }
+}
+
+static void rgb888_to_gray(const uint8_t* s, uint8_t* d, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, s += 24, d += 8) {
+        v8u32_t r, g, b;
+        for (uint8_t k = 0; k < 8; ++k) {
+            r[k] = s[k * 3];
+            g[k] = s[k * 3 + 1];
+            b[k] = s[k * 3 + 2];
+        }
+        luma(r, g, b, d);
+    }
+    for (; i < n; ++i, s += 3) *d++ = (s[0] * 299 + s[1] * 587 + s[2] * 114) / 1000;
+}
+
+static void gray_to_rgb888(const uint8_t* s, uint8_t* d, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16, s += 16, d += 48) {
+        v16u8_t c;
+        memcpy(&c, s, sizeof(c));
+        for (uint8_t k = 0; k < 16; ++k) d[k * 3] = d[k * 3 + 1] = d[k * 3 + 2] = c[k];
+    }
+    for (; i < n; ++i, d += 3) d[0] = d[1] = d[2] = *s++;
+}
+
+static void gray_to_rgb565(const uint8_t* s, uint8_t* d, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, s += 8, d += 16) {
+        v8u16_t c;
+        for (uint8_t k = 0; k < 8; ++k) c[k] = s[k];
+        // byte 0 is RRRRRGGG and byte 1 is GGGBBBBB
+        v8u16_t p = (c & 0xF8) | (c >> 5) | ((((c << 3) & 0xE0) | (c >> 3)) << 8);
+        memcpy(d, &p, sizeof(p));
+    }
+    for (; i < n; ++i, d += 2) {
+        uint8_t c = *s++;
+        d[0]      = (c & 0xF8) | (c >> 5);
+        d[1]      = ((c << 3) & 0xE0) | (c >> 3);
+    }
 }
 
-EL_ATTR_WEAK void rgb888_to_rgb888(const el_img_t* src, el_img_t* dst) {
+template <size_t BPP> static void copy(const uint8_t* s, uint8_t* d, size_t n) { memcpy(d, s, n * BPP); }
+
+// converts n contiguous pixels without scaling, rotation or lut, nullptr if there is no vectorized kernel
+static span_fn_t select(el_pixel_format_t src_format, el_pixel_format_t dst_format) {
+    switch (src_format) {
+    case EL_PIXEL_FORMAT_RGB888:
+        if (dst_format == EL_PIXEL_FORMAT_RGB888) return &copy<3>;
+        if (dst_format == EL_PIXEL_FORMAT_GRAYSCALE) return &rgb888_to_gray;
+        break;
+    case EL_PIXEL_FORMAT_RGB565:
+        if (dst_format == EL_PIXEL_FORMAT_RGB888) return &rgb565_to_rgb888;
+        if (dst_format == EL_PIXEL_FORMAT_RGB565) return &copy<2>;
+        if (dst_format == EL_PIXEL_FORMAT_GRAYSCALE) return &rgb565_to_gray;
+        break;
+    case EL_PIXEL_FORMAT_GRAYSCALE:
+        if (dst_format == EL_PIXEL_FORMAT_RGB888) return &gray_to_rgb888;
+        if (dst_format == EL_PIXEL_FORMAT_RGB565) return &gray_to_rgb565;
+        if (dst_format == EL_PIXEL_FORMAT_GRAYSCALE) return &copy<1>;
+        break;
+    default:
+        break;
+    }
+    return nullptr;
+}
+
+}  // namespace simd
+
+#endif
+
+#if CONFIG_EL_CV_THREADS > 1
+
+namespace parallel {
+
+// a fixed set of workers started on first use, one job (a set of slices) runs at a time and the calling thread
+// always takes slice 0
+class WorkerPool {
+   public:
+    static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    void run(uint8_t slices, const std::function<void(uint8_t)>& fn) {
+        std::lock_guard<std::mutex> job_lock(_job_mutex);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _fn      = &fn;
+            _slices  = slices;
+            _pending = slices - 1;
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        fn(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _pending == 0; });
+        _fn = nullptr;
+    }
+
+   private:
+    WorkerPool() : _fn(nullptr), _slices(0), _pending(0), _generation(0), _stop(false) {
+        for (uint8_t k = 1; k < CONFIG_EL_CV_THREADS; ++k) _workers[k - 1] = std::thread(&WorkerPool::work, this, k);
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto& worker : _workers) worker.join();
+    }
+
+    void work(uint8_t slice) {
+        uint32_t seen = 0;
+        for (;;) {
+            const std::function<void(uint8_t)>* fn = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&] { return _stop || _generation != seen; });
+                if (_stop) return;
+                seen = _generation;
+                if (slice >= _slices) continue;
+                fn = _fn;
+            }
+
+            (*fn)(slice);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0) _done.notify_one();
+        }
+    }
+
+    std::mutex                          _job_mutex;
+    std::mutex                          _mutex;
+    std::condition_variable             _wake;
+    std::condition_variable             _done;
+    const std::function<void(uint8_t)>* _fn;
+    uint8_t                             _slices;
+    uint8_t                             _pending;
+    uint32_t                            _generation;
+    bool                                _stop;
+    std::thread                         _workers[CONFIG_EL_CV_THREADS - 1];
+};
+
+}  // namespace parallel
+
+#endif
+
+// the direct kernels sample nearest one pixel at a time, rgb_to_rgb only vectorizes unscaled and unrotated spans
+// without a lut
+EL_ATTR_WEAK void rgb888_to_rgb888(const el_img_t* src, el_img_t* dst, const el_img_lut_t* lut) {
     uint16_t sw = src->width;
     uint16_t sh = src->height;
     uint16_t dw = dst->width;
@@ -138,6 +412,7 @@ EL_ATTR_WEAK void rgb888_to_rgb888(const el_img_t* src, el_img_t* dst) {
     uint32_t beta_h = (sh << 16) / dh;
 
     uint32_t i_mul_bh_sw = 0;
+    uint32_t i_mul_dw    = 0;
 
     uint32_t init_index = 0;
     uint32_t index      = 0;
@@ -145,51 +420,52 @@ EL_ATTR_WEAK void rgb888_to_rgb888(const el_img_t* src, el_img_t* dst) {
     const uint8_t* src_p = src->data;
     uint8_t*       dst_p = dst->data;
 
-    switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
+    b24_t b24{};
 
-                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) =
-                  *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-            }
+    if (!lut) {
+        if (dst->rotate == EL_PIXEL_ROTATE_0 && sw == dw && sh == dh) {
+            memcpy(dst_p, src_p, dst->size < src->size ? dst->size : src->size);
+            return;
         }
-        break;
+        lut = &IDENTITY_LOOKUP_TABLE;
+    }
+
+    const uint8_t* lut_r = lut->table[0];
+    const uint8_t* lut_g = lut->table[1];
+    const uint8_t* lut_b = lut->table[2];
 
+    switch (dst->rotate) {
     case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
+
+                b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
 
                 *reinterpret_cast<b24_t*>(dst_p + (index * 3)) =
-                  *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
+                  b24_t{.b0_8 = lut_r[b24.b0_8], .b8_16 = lut_g[b24.b8_16], .b16_24 = lut_b[b24.b16_24]};
             }
         }
         break;
 
-    case EL_PIXEL_ROTATE_270:
+    default:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
+            i_mul_dw    = i * dw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
+                index      = j + i_mul_dw;
+
+                b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
 
                 *reinterpret_cast<b24_t*>(dst_p + (index * 3)) =
-                  *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
+                  b24_t{.b0_8 = lut_r[b24.b0_8], .b8_16 = lut_g[b24.b8_16], .b16_24 = lut_b[b24.b16_24]};
             }
         }
-        break;
-
-    default:
-        memcpy(dst_p, src_p, dst->size < src->size ? dst->size : src->size);
     }
 }
 
@@ -217,58 +493,18 @@ EL_ATTR_WEAK void rgb888_to_rgb565(const el_img_t* src, el_img_t* dst) {
     uint8_t b = 0;
 
     switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
-
-                b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b24.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b24.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b24.b0_8 & 0x07) << 3) | ((b24.b8_16 & 0xE0) >> 5)];
-
-                *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
-                  b16_t{.b0_8  = static_cast<uint8_t>((r & 0xF8) | (g >> 5)),
-                        .b8_16 = static_cast<uint8_t>(((g << 3) & 0xE0) | (b >> 3))};
-            }
-        }
-        break;
-
     case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
-
-                b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b24.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b24.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b24.b0_8 & 0x07) << 3) | ((b24.b8_16 & 0xE0) >> 5)];
-
-                *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
-                  b16_t{.b0_8  = static_cast<uint8_t>((r & 0xF8) | (g >> 5)),
-                        .b8_16 = static_cast<uint8_t>(((g << 3) & 0xE0) | (b >> 3))};
-            }
-        }
-        break;
-
-    case EL_PIXEL_ROTATE_270:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
 
                 b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b24.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b24.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b24.b0_8 & 0x07) << 3) | ((b24.b8_16 & 0xE0) >> 5)];
+                r   = b24.b0_8;
+                g   = b24.b8_16;
+                b   = b24.b16_24;
 
                 *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
                   b16_t{.b0_8  = static_cast<uint8_t>((r & 0xF8) | (g >> 5)),
@@ -287,9 +523,9 @@ EL_ATTR_WEAK void rgb888_to_rgb565(const el_img_t* src, el_img_t* dst) {
                 index      = j + i_mul_dw;
 
                 b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b24.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b24.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b24.b0_8 & 0x07) << 3) | ((b24.b8_16 & 0xE0) >> 5)];
+                r   = b24.b0_8;
+                g   = b24.b8_16;
+                b   = b24.b16_24;
 
                 *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
                   b16_t{.b0_8  = static_cast<uint8_t>((r & 0xF8) | (g >> 5)),
@@ -299,7 +535,7 @@ EL_ATTR_WEAK void rgb888_to_rgb565(const el_img_t* src, el_img_t* dst) {
     }
 }
 
-EL_ATTR_WEAK void rgb888_to_gray(const el_img_t* src, el_img_t* dst) {
+EL_ATTR_WEAK void rgb888_to_gray(const el_img_t* src, el_img_t* dst, const el_img_lut_t* lut) {
     uint16_t sw = src->width;
     uint16_t sh = src->height;
     uint16_t dw = dst->width;
@@ -323,57 +559,23 @@ EL_ATTR_WEAK void rgb888_to_gray(const el_img_t* src, el_img_t* dst) {
     uint8_t g = 0;
     uint8_t b = 0;
 
-    switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
-
-                b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b24.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b24.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b24.b0_8 & 0x07) << 3) | ((b24.b8_16 & 0xE0) >> 5)];
-
-                dst_p[index] = (r * 299 + g * 587 + b * 114) / 1000;
-            }
-        }
-        break;
+    const uint8_t* lut_y = (lut ? lut : &IDENTITY_LOOKUP_TABLE)->table[0];
 
+    switch (dst->rotate) {
     case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
 
                 b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b24.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b24.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b24.b0_8 & 0x07) << 3) | ((b24.b8_16 & 0xE0) >> 5)];
+                r   = b24.b0_8;
+                g   = b24.b8_16;
+                b   = b24.b16_24;
 
-                dst_p[index] = (r * 299 + g * 587 + b * 114) / 1000;
-            }
-        }
-        break;
-
-    case EL_PIXEL_ROTATE_270:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
-
-                b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b24.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b24.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b24.b0_8 & 0x07) << 3) | ((b24.b8_16 & 0xE0) >> 5)];
-
-                dst_p[index] = (r * 299 + g * 587 + b * 114) / 1000;
+                dst_p[index] = lut_y[(r * 299 + g * 587 + b * 114) / 1000];
             }
         }
         break;
@@ -388,17 +590,17 @@ EL_ATTR_WEAK void rgb888_to_gray(const el_img_t* src, el_img_t* dst) {
                 index      = j + i_mul_dw;
 
                 b24 = *reinterpret_cast<const b24_t*>(src_p + (init_index * 3));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b24.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b24.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b24.b0_8 & 0x07) << 3) | ((b24.b8_16 & 0xE0) >> 5)];
+                r   = b24.b0_8;
+                g   = b24.b8_16;
+                b   = b24.b16_24;
 
-                dst_p[index] = (r * 299 + g * 587 + b * 114) / 1000;
+                dst_p[index] = lut_y[(r * 299 + g * 587 + b * 114) / 1000];
             }
         }
     }
 }
 
-EL_ATTR_WEAK void rgb565_to_rgb888(const el_img_t* src, el_img_t* dst) {
+EL_ATTR_WEAK void rgb565_to_rgb888(const el_img_t* src, el_img_t* dst, const el_img_lut_t* lut) {
     uint16_t sw = src->width;
     uint16_t sh = src->height;
     uint16_t dw = dst->width;
@@ -422,55 +624,31 @@ EL_ATTR_WEAK void rgb565_to_rgb888(const el_img_t* src, el_img_t* dst) {
     uint8_t g = 0;
     uint8_t b = 0;
 
-    switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
-
-                b16 = *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b16.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b16.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
+    // the output lut is folded into the 5/6 bit expansion tables, so the fused path costs no extra lookup per pixel
+    uint8_t lut_r5[32];
+    uint8_t lut_g6[64];
+    uint8_t lut_b5[32];
 
-                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = r, .b8_16 = g, .b16_24 = b};
-            }
-        }
-        break;
+    if (!lut) lut = &IDENTITY_LOOKUP_TABLE;
+    for (uint8_t i = 0; i < 32; ++i) {
+        lut_r5[i] = lut->table[0][RGB565_TO_RGB888_LOOKUP_TABLE_5[i]];
+        lut_b5[i] = lut->table[2][RGB565_TO_RGB888_LOOKUP_TABLE_5[i]];
+    }
+    for (uint8_t i = 0; i < 64; ++i) lut_g6[i] = lut->table[1][RGB565_TO_RGB888_LOOKUP_TABLE_6[i]];
 
+    switch (dst->rotate) {
     case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
-
-                b16 = *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b16.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b16.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
-
-                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = r, .b8_16 = g, .b16_24 = b};
-            }
-        }
-        break;
-
-    case EL_PIXEL_ROTATE_270:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
 
                 b16 = *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b16.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b16.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
+                r   = lut_r5[(b16.b0_8 & 0xF8) >> 3];
+                b   = lut_b5[b16.b8_16 & 0x1F];
+                g   = lut_g6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
 
                 *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = r, .b8_16 = g, .b16_24 = b};
             }
@@ -487,9 +665,9 @@ EL_ATTR_WEAK void rgb565_to_rgb888(const el_img_t* src, el_img_t* dst) {
                 index      = j + i_mul_dw;
 
                 b16 = *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b16.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b16.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
+                r   = lut_r5[(b16.b0_8 & 0xF8) >> 3];
+                b   = lut_b5[b16.b8_16 & 0x1F];
+                g   = lut_g6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
 
                 *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = r, .b8_16 = g, .b16_24 = b};
             }
@@ -507,6 +685,7 @@ EL_ATTR_WEAK void rgb565_to_rgb565(const el_img_t* src, el_img_t* dst) {
     uint32_t beta_h = (sh << 16) / dh;
 
     uint32_t i_mul_bh_sw = 0;
+    uint32_t i_mul_dw    = 0;
 
     uint32_t init_index = 0;
     uint32_t index      = 0;
@@ -515,27 +694,13 @@ EL_ATTR_WEAK void rgb565_to_rgb565(const el_img_t* src, el_img_t* dst) {
     uint8_t*       dst_p = dst->data;
 
     switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
-
-                *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
-                  *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
-            }
-        }
-        break;
-
     case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
 
                 *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
                   *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
@@ -543,26 +708,27 @@ EL_ATTR_WEAK void rgb565_to_rgb565(const el_img_t* src, el_img_t* dst) {
         }
         break;
 
-    case EL_PIXEL_ROTATE_270:
+    default:
+        if (sw == dw && sh == dh) {
+            memcpy(dst_p, src_p, dst->size < src->size ? dst->size : src->size);
+            break;
+        }
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
+            i_mul_dw    = i * dw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
+                index      = j + i_mul_dw;
 
                 *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
                   *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
             }
         }
-        break;
-
-    default:
-        memcpy(dst_p, src_p, dst->size < src->size ? dst->size : src->size);
     }
 }
 
-EL_ATTR_WEAK void rgb565_to_gray(const el_img_t* src, el_img_t* dst) {
+EL_ATTR_WEAK void rgb565_to_gray(const el_img_t* src, el_img_t* dst, const el_img_lut_t* lut) {
     uint16_t sw = src->width;
     uint16_t sh = src->height;
     uint16_t dw = dst->width;
@@ -586,57 +752,23 @@ EL_ATTR_WEAK void rgb565_to_gray(const el_img_t* src, el_img_t* dst) {
     uint8_t g = 0;
     uint8_t b = 0;
 
+    const uint8_t* lut_y = (lut ? lut : &IDENTITY_LOOKUP_TABLE)->table[0];
+
     switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
+    case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
 
                 b16 = *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
                 r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b16.b0_8 & 0xF8) >> 3];
                 b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b16.b8_16 & 0x1F];
                 g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
 
-                dst_p[index] = (r * 299 + g * 587 + b * 114) / 1000;
-            }
-        }
-        break;
-
-    case EL_PIXEL_ROTATE_180:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
-
-                b16 = *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b16.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b16.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
-
-                dst_p[index] = (r * 299 + g * 587 + b * 114) / 1000;
-            }
-        }
-        break;
-
-    case EL_PIXEL_ROTATE_270:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
-
-                b16 = *reinterpret_cast<const b16_t*>(src_p + (init_index << 1));
-                r   = RGB565_TO_RGB888_LOOKUP_TABLE_5[(b16.b0_8 & 0xF8) >> 3];
-                b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b16.b8_16 & 0x1F];
-                g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
-
-                dst_p[index] = (r * 299 + g * 587 + b * 114) / 1000;
+                dst_p[index] = lut_y[(r * 299 + g * 587 + b * 114) / 1000];
             }
         }
         break;
@@ -655,13 +787,13 @@ EL_ATTR_WEAK void rgb565_to_gray(const el_img_t* src, el_img_t* dst) {
                 b   = RGB565_TO_RGB888_LOOKUP_TABLE_5[b16.b8_16 & 0x1F];
                 g   = RGB565_TO_RGB888_LOOKUP_TABLE_6[((b16.b0_8 & 0x07) << 3) | ((b16.b8_16 & 0xE0) >> 5)];
 
-                dst_p[index] = (r * 299 + g * 587 + b * 114) / 1000;
+                dst_p[index] = lut_y[(r * 299 + g * 587 + b * 114) / 1000];
             }
         }
     }
 }
 
-EL_ATTR_WEAK void gray_to_rgb888(const el_img_t* src, el_img_t* dst) {
+EL_ATTR_WEAK void gray_to_rgb888(const el_img_t* src, el_img_t* dst, const el_img_lut_t* lut) {
     uint16_t sw = src->width;
     uint16_t sh = src->height;
     uint16_t dw = dst->width;
@@ -681,48 +813,24 @@ EL_ATTR_WEAK void gray_to_rgb888(const el_img_t* src, el_img_t* dst) {
 
     uint8_t c = 0;
 
-    switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
-
-                c = src_p[init_index];
+    if (!lut) lut = &IDENTITY_LOOKUP_TABLE;
 
-                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = c, .b8_16 = c, .b16_24 = c};
-            }
-        }
-        break;
+    const uint8_t* lut_r = lut->table[0];
+    const uint8_t* lut_g = lut->table[1];
+    const uint8_t* lut_b = lut->table[2];
 
+    switch (dst->rotate) {
     case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
-
-                c = src_p[init_index];
-
-                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = c, .b8_16 = c, .b16_24 = c};
-            }
-        }
-        break;
-
-    case EL_PIXEL_ROTATE_270:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
 
                 c = src_p[init_index];
 
-                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = c, .b8_16 = c, .b16_24 = c};
+                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = lut_r[c], .b8_16 = lut_g[c], .b16_24 = lut_b[c]};
             }
         }
         break;
@@ -738,7 +846,7 @@ EL_ATTR_WEAK void gray_to_rgb888(const el_img_t* src, el_img_t* dst) {
 
                 c = src_p[init_index];
 
-                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = c, .b8_16 = c, .b16_24 = c};
+                *reinterpret_cast<b24_t*>(dst_p + (index * 3)) = b24_t{.b0_8 = lut_r[c], .b8_16 = lut_g[c], .b16_24 = lut_b[c]};
             }
         }
     }
@@ -765,47 +873,13 @@ EL_ATTR_WEAK void gray_to_rgb565(const el_img_t* src, el_img_t* dst) {
     uint8_t c = 0;
 
     switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
-
-                c = src_p[init_index];
-
-                *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
-                  b16_t{.b0_8  = static_cast<uint8_t>((c & 0xF8) | (c >> 5)),
-                        .b8_16 = static_cast<uint8_t>(((c << 3) & 0xE0) | (c >> 3))};
-            }
-        }
-        break;
-
     case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
-
-                c = src_p[init_index];
-
-                *reinterpret_cast<b16_t*>(dst_p + (index << 1)) =
-                  b16_t{.b0_8  = static_cast<uint8_t>((c & 0xF8) | (c >> 5)),
-                        .b8_16 = static_cast<uint8_t>(((c << 3) & 0xE0) | (c >> 3))};
-            }
-        }
-        break;
-
-    case EL_PIXEL_ROTATE_270:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
 
                 c = src_p[init_index];
 
@@ -835,7 +909,7 @@ EL_ATTR_WEAK void gray_to_rgb565(const el_img_t* src, el_img_t* dst) {
     }
 }
 
-EL_ATTR_WEAK void gray_to_gray(const el_img_t* src, el_img_t* dst) {
+EL_ATTR_WEAK void gray_to_gray(const el_img_t* src, el_img_t* dst, const el_img_lut_t* lut) {
     uint16_t sw = src->width;
     uint16_t sh = src->height;
     uint16_t dw = dst->width;
@@ -845,6 +919,7 @@ EL_ATTR_WEAK void gray_to_gray(const el_img_t* src, el_img_t* dst) {
     uint32_t beta_h = (sh << 16) / dh;
 
     uint32_t i_mul_bh_sw = 0;
+    uint32_t i_mul_dw    = 0;
 
     uint32_t init_index = 0;
     uint32_t index      = 0;
@@ -852,139 +927,1330 @@ EL_ATTR_WEAK void gray_to_gray(const el_img_t* src, el_img_t* dst) {
     const uint8_t* src_p = src->data;
     uint8_t*       dst_p = dst->data;
 
-    switch (dst->rotate) {
-    case EL_PIXEL_ROTATE_90:
-        for (uint16_t i = 0; i < dh; ++i) {
-            i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
-
-            for (uint16_t j = 0; j < dw; ++j) {
-                init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = (j % dw) * dh + ((dh - 1) - ((j / dw) + i));
-
-                dst_p[index] = src_p[init_index];
-            }
+    if (!lut) {
+        if (dst->rotate == EL_PIXEL_ROTATE_0 && sw == dw && sh == dh) {
+            memcpy(dst_p, src_p, dst->size < src->size ? dst->size : src->size);
+            return;
         }
-        break;
+        lut = &IDENTITY_LOOKUP_TABLE;
+    }
+
+    const uint8_t* lut_y = lut->table[0];
 
+    switch (dst->rotate) {
     case EL_PIXEL_ROTATE_180:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) + ((dh - 1) - ((j / dw) + i)) * dw;
+                index      = ((dw - 1) - j) + ((dh - 1) - i) * dw;
 
-                dst_p[index] = src_p[init_index];
+                dst_p[index] = lut_y[src_p[init_index]];
             }
         }
         break;
 
-    case EL_PIXEL_ROTATE_270:
+    default:
         for (uint16_t i = 0; i < dh; ++i) {
             i_mul_bh_sw = ((i * beta_h) >> 16) * sw;
+            i_mul_dw    = i * dw;
 
             for (uint16_t j = 0; j < dw; ++j) {
                 init_index = ((j * beta_w) >> 16) + i_mul_bh_sw;
-                index      = ((dw - 1) - (j % dw)) * dh + (j / dw) + i;
+                index      = j + i_mul_dw;
 
-                dst_p[index] = src_p[init_index];
+                dst_p[index] = lut_y[src_p[init_index]];
             }
         }
-        break;
-
-    default:
-        memcpy(dst_p, src_p, dst->size < src->size ? dst->size : src->size);
     }
 }
 
 // Note: Current downscaling algorithm implementation is INTER_NEARST
-EL_ATTR_WEAK void rgb_to_rgb(const el_img_t* src, el_img_t* dst) {
+EL_ATTR_WEAK void rgb_to_rgb(const el_img_t* src, el_img_t* dst, const el_img_lut_t* lut) {
+    // the direct kernels only flip, transposing rotations are converted tile by tile by the plans
+    EL_ASSERT(dst->rotate == EL_PIXEL_ROTATE_0 || dst->rotate == EL_PIXEL_ROTATE_180);
+
+#if CONFIG_EL_CV_SIMD
+    // unscaled and unrotated conversions without a lut are one contiguous span
+    if (!lut && dst->rotate == EL_PIXEL_ROTATE_0 && src->width == dst->width && src->height == dst->height) {
+        auto span_fn = simd::select(src->format, dst->format);
+        if (span_fn) {
+            span_fn(src->data, dst->data, static_cast<size_t>(src->width) * src->height);
+            return;
+        }
+    }
+#endif
+
     if (src->format == EL_PIXEL_FORMAT_RGB888) {
         if (dst->format == EL_PIXEL_FORMAT_RGB888)
-            rgb888_to_rgb888(src, dst);
+            rgb888_to_rgb888(src, dst, lut);
         else if (dst->format == EL_PIXEL_FORMAT_RGB565)
             rgb888_to_rgb565(src, dst);
         else if (dst->format == EL_PIXEL_FORMAT_GRAYSCALE)
-            rgb888_to_gray(src, dst);
+            rgb888_to_gray(src, dst, lut);
     }
 
     else if (src->format == EL_PIXEL_FORMAT_RGB565) {
         if (dst->format == EL_PIXEL_FORMAT_RGB888)
-            rgb565_to_rgb888(src, dst);
+            rgb565_to_rgb888(src, dst, lut);
         else if (dst->format == EL_PIXEL_FORMAT_RGB565)
             rgb565_to_rgb565(src, dst);
         else if (dst->format == EL_PIXEL_FORMAT_GRAYSCALE)
-            rgb565_to_gray(src, dst);
+            rgb565_to_gray(src, dst, lut);
     }
 
     else if (src->format == EL_PIXEL_FORMAT_GRAYSCALE) {
         if (dst->format == EL_PIXEL_FORMAT_RGB888)
-            gray_to_rgb888(src, dst);
+            gray_to_rgb888(src, dst, lut);
         else if (dst->format == EL_PIXEL_FORMAT_RGB565)
             gray_to_rgb565(src, dst);
         else if (dst->format == EL_PIXEL_FORMAT_GRAYSCALE)
-            gray_to_gray(src, dst);
+            gray_to_gray(src, dst, lut);
+    }
+}
+
+static void build_resize_coeff(resize_coeff_t* tab, uint16_t s, uint16_t d, el_pixel_interp_t interp) {
+    for (uint16_t j = 0; j < d; ++j) {
+        if (interp == EL_PIXEL_INTERP_BILINEAR) {
+            // center aligned source position (j + 0.5) * s / d - 0.5 in Q8
+            int32_t pos = static_cast<int32_t>(((2u * j + 1u) * static_cast<uint64_t>(s) << 7) / d) - 128;
+            pos         = pos < 0 ? 0 : pos;
+
+            uint16_t index = static_cast<uint16_t>(pos >> 8);
+            if (index + 1u >= s)
+                tab[j] = resize_coeff_t{.index = static_cast<uint16_t>(s - 1), .span = 0, .coeff = 0};
+            else
+                tab[j] = resize_coeff_t{.index = index, .span = 1, .coeff = static_cast<uint32_t>(pos & 0xFF)};
+        } else {
+            uint32_t begin = (static_cast<uint32_t>(j) * s) / d;
+            uint32_t end   = (static_cast<uint32_t>(j + 1) * s) / d;
+            end            = end > begin ? end : begin + 1;
+
+            tab[j] = resize_coeff_t{.index = static_cast<uint16_t>(begin),
+                                    .span  = static_cast<uint16_t>(end - begin),
+                                    .coeff = 65536u / (end - begin)};
+        }
+    }
+}
+
+EL_ATTR_ALWAYS_INLINE inline void yuv_to_rgb(int32_t y, int32_t u, int32_t v, uint8_t* rgb) {
+    // BT.601 full range in Q16, r = y + 1.4065 v, g = y - 0.3455 u - 0.7169 v, b = y + 1.779 u
+    u -= 128;
+    v -= 128;
+    y <<= 16;
+
+    int32_t r = (y + 92176 * v + 32768) >> 16;
+    int32_t g = (y - 22643 * u - 46983 * v + 32768) >> 16;
+    int32_t b = (y + 116589 * u + 32768) >> 16;
+
+    rgb[0] = static_cast<uint8_t>(EL_CLIP(r, 0, 255));
+    rgb[1] = static_cast<uint8_t>(EL_CLIP(g, 0, 255));
+    rgb[2] = static_cast<uint8_t>(EL_CLIP(b, 0, 255));
+}
+
+constexpr bool is_yuv_format(el_pixel_format_t format) {
+    return format == EL_PIXEL_FORMAT_YUV422 || format == EL_PIXEL_FORMAT_YUYV || format == EL_PIXEL_FORMAT_UYVY ||
+           format == EL_PIXEL_FORMAT_NV12 || format == EL_PIXEL_FORMAT_NV21;
+}
+
+// byte step between horizontally adjacent luma samples
+constexpr uint8_t yuv_y_step(el_pixel_format_t format) {
+    return format == EL_PIXEL_FORMAT_YUYV || format == EL_PIXEL_FORMAT_UYVY ? 2 : 1;
+}
+
+// byte step between horizontally adjacent chroma samples, chroma is subsampled by 2 horizontally in all layouts
+constexpr uint8_t yuv_c_step(el_pixel_format_t format) {
+    return format == EL_PIXEL_FORMAT_YUYV || format == EL_PIXEL_FORMAT_UYVY ? 4
+           : format == EL_PIXEL_FORMAT_NV12 || format == EL_PIXEL_FORMAT_NV21 ? 2
+                                                                              : 1;
+}
+
+// locates the first y, u and v samples of source row y
+static void locate_yuv_row(const el_img_t* src, uint16_t y, const uint8_t** rows) {
+    size_t         sw   = src->width;
+    size_t         area = sw * src->height;
+    const uint8_t* p    = src->data;
+
+    switch (src->format) {
+    case EL_PIXEL_FORMAT_YUYV:
+        p += y * el_img_pitch(src);
+        rows[0] = p;
+        rows[1] = p + 1;
+        rows[2] = p + 3;
+        break;
+    case EL_PIXEL_FORMAT_UYVY:
+        p += y * el_img_pitch(src);
+        rows[0] = p + 1;
+        rows[1] = p;
+        rows[2] = p + 2;
+        break;
+    case EL_PIXEL_FORMAT_NV12:
+        rows[0] = p + y * sw;
+        rows[1] = p + area + (y >> 1) * sw;
+        rows[2] = rows[1] + 1;
+        break;
+    case EL_PIXEL_FORMAT_NV21:
+        rows[0] = p + y * sw;
+        rows[2] = p + area + (y >> 1) * sw;
+        rows[1] = rows[2] + 1;
+        break;
+    default:
+        // planar 4:2:2, Y plane followed by U and V planes of half width
+        rows[0] = p + y * sw;
+        rows[1] = p + area + ((y * sw) >> 1);
+        rows[2] = rows[1] + (area >> 1);
+    }
+}
+
+template <el_pixel_format_t F> static void yuv_row_to_rgb(const uint8_t* const* rows, uint16_t w, uint8_t* d) {
+    constexpr uint8_t ys = yuv_y_step(F);
+    constexpr uint8_t cs = yuv_c_step(F);
+
+    const uint8_t* py = rows[0];
+    const uint8_t* pu = rows[1];
+    const uint8_t* pv = rows[2];
+
+    // one chroma pair per two pixels
+    uint16_t x = 0;
+    for (; x + 1 < w; x += 2, py += ys << 1, pu += cs, pv += cs, d += 6) {
+        yuv_to_rgb(py[0], *pu, *pv, d);
+        yuv_to_rgb(py[ys], *pu, *pv, d + 3);
+    }
+    if (x < w) yuv_to_rgb(py[0], *pu, *pv, d);
+}
+
+// returns source row y as ch (1 or 3) interleaved channels, in place if the source layout already matches
+static const uint8_t* fetch_src_row(const el_img_t* src, uint16_t y, uint8_t ch, uint8_t* buf) {
+    uint16_t       sw = src->width;
+    const uint8_t* p  = nullptr;
+    uint8_t*       d  = buf;
+
+    switch (src->format) {
+    case EL_PIXEL_FORMAT_RGB888:
+        p = src->data + y * el_img_pitch(src);
+        if (ch == 3) return p;
+        for (uint16_t x = 0; x < sw; ++x, p += 3) *d++ = (p[0] * 299 + p[1] * 587 + p[2] * 114) / 1000;
+        return buf;
+
+    case EL_PIXEL_FORMAT_RGB565:
+        p = src->data + y * el_img_pitch(src);
+        for (uint16_t x = 0; x < sw; ++x, p += 2) {
+            uint8_t r = RGB565_TO_RGB888_LOOKUP_TABLE_5[(p[0] & 0xF8) >> 3];
+            uint8_t b = RGB565_TO_RGB888_LOOKUP_TABLE_5[p[1] & 0x1F];
+            uint8_t g = RGB565_TO_RGB888_LOOKUP_TABLE_6[((p[0] & 0x07) << 3) | ((p[1] & 0xE0) >> 5)];
+            if (ch == 3) {
+                *d++ = r;
+                *d++ = g;
+                *d++ = b;
+            } else
+                *d++ = (r * 299 + g * 587 + b * 114) / 1000;
+        }
+        return buf;
+
+    case EL_PIXEL_FORMAT_GRAYSCALE:
+        return src->data + y * el_img_pitch(src);
+
+    case EL_PIXEL_FORMAT_YUV422:
+    case EL_PIXEL_FORMAT_YUYV:
+    case EL_PIXEL_FORMAT_UYVY:
+    case EL_PIXEL_FORMAT_NV12:
+    case EL_PIXEL_FORMAT_NV21: {
+        const uint8_t* rows[3];
+        locate_yuv_row(src, y, rows);
+        if (ch == 1) {
+            // grayscale only needs the luma samples
+            if (yuv_y_step(src->format) == 1) return rows[0];
+            p = rows[0];
+            for (uint16_t x = 0; x < sw; ++x, p += 2) *d++ = *p;
+            return buf;
+        }
+        switch (src->format) {
+        case EL_PIXEL_FORMAT_YUYV:
+            yuv_row_to_rgb<EL_PIXEL_FORMAT_YUYV>(rows, sw, buf);
+            break;
+        case EL_PIXEL_FORMAT_UYVY:
+            yuv_row_to_rgb<EL_PIXEL_FORMAT_UYVY>(rows, sw, buf);
+            break;
+        case EL_PIXEL_FORMAT_NV12:
+            yuv_row_to_rgb<EL_PIXEL_FORMAT_NV12>(rows, sw, buf);
+            break;
+        case EL_PIXEL_FORMAT_NV21:
+            yuv_row_to_rgb<EL_PIXEL_FORMAT_NV21>(rows, sw, buf);
+            break;
+        default:
+            yuv_row_to_rgb<EL_PIXEL_FORMAT_YUV422>(rows, sw, buf);
+        }
+        return buf;
+    }
+
+    default:
+        return buf;
+    }
+}
+
+template <uint8_t CH> static void h_bilinear(const uint8_t* s, const resize_coeff_t* tab, uint16_t* d, uint16_t dw) {
+    for (uint16_t j = 0; j < dw; ++j) {
+        const uint8_t* p0 = s + tab[j].index * CH;
+        const uint8_t* p1 = p0 + tab[j].span * CH;
+        uint32_t       w1 = tab[j].coeff;
+        uint32_t       w0 = 256u - w1;
+        for (uint8_t c = 0; c < CH; ++c) *d++ = static_cast<uint16_t>(p0[c] * w0 + p1[c] * w1);
+    }
+}
+
+template <uint8_t CH> static void h_area(const uint8_t* s, const resize_coeff_t* tab, uint32_t* acc, uint16_t dw) {
+    for (uint16_t j = 0; j < dw; ++j) {
+        const uint8_t* p = s + tab[j].index * CH;
+        uint32_t       sum[CH]{};
+        for (uint16_t k = 0; k < tab[j].span; ++k, p += CH)
+            for (uint8_t c = 0; c < CH; ++c) sum[c] += p[c];
+        // Q8 average, at most 255 << 8
+        for (uint8_t c = 0; c < CH; ++c) *acc++ += (sum[c] * tab[j].coeff) >> 8;
+    }
+}
+
+// stores a channel through its lut, or as a float looked up in its normalization table (unaligned rows are allowed)
+template <bool F>
+EL_ATTR_ALWAYS_INLINE inline void store_channel(uint8_t* d, const uint8_t* lut, const float* norm, uint8_t v) {
+    if constexpr (F)
+        memcpy(d, norm + v, sizeof(float));
+    else
+        *d = lut[v];
+}
+
+// writes n pixels of ch interleaved channels starting at destination byte offset idx, advancing by step bytes, the
+// channels of float (norm is not null) and planar destinations are stored plane bytes apart
+static void store_dst_row(uint8_t*              dst_p,
+                          el_pixel_format_t     format,
+                          uint16_t              n,
+                          int32_t               idx,
+                          int32_t               step,
+                          const uint8_t*        line,
+                          uint8_t               ch,
+                          const uint8_t* const* lut,
+                          size_t                plane,
+                          const float*          norm) {
+    const uint8_t* lut_r = lut[0];
+    const uint8_t* lut_g = lut[1];
+    const uint8_t* lut_b = lut[2];
+
+    if (norm && format == EL_PIXEL_FORMAT_GRAYSCALE) {
+        for (uint16_t j = 0; j < n; ++j, idx += step, line += ch) {
+            uint8_t c = ch == 3 ? (line[0] * 299 + line[1] * 587 + line[2] * 114) / 1000 : *line;
+            store_channel<true>(dst_p + idx, lut_r, norm, c);
+        }
+        return;
+    }
+
+    if (norm) {
+        for (uint16_t j = 0; j < n; ++j, idx += step, line += ch) {
+            store_channel<true>(dst_p + idx, lut_r, norm, line[0]);
+            store_channel<true>(dst_p + idx + plane, lut_g, norm + 256, line[ch >> 1]);
+            store_channel<true>(dst_p + idx + plane * 2, lut_b, norm + 512, line[ch - 1]);
+        }
+        return;
+    }
+
+    if (format == EL_PIXEL_FORMAT_RGB888_PLANAR) {
+        for (uint16_t j = 0; j < n; ++j, idx += step, line += ch) {
+            uint8_t* d   = dst_p + idx;
+            d[0]         = lut_r[line[0]];
+            d[plane]     = lut_g[line[ch >> 1]];
+            d[plane * 2] = lut_b[line[ch - 1]];
+        }
+        return;
+    }
+
+    switch (format) {
+    case EL_PIXEL_FORMAT_RGB888:
+        for (uint16_t j = 0; j < n; ++j, idx += step, line += ch) {
+            uint8_t* d = dst_p + idx;
+            d[0]       = lut_r[line[0]];
+            d[1]       = lut_g[line[ch >> 1]];
+            d[2]       = lut_b[line[ch - 1]];
+        }
+        break;
+
+    case EL_PIXEL_FORMAT_RGB565:
+        for (uint16_t j = 0; j < n; ++j, idx += step, line += ch) {
+            uint8_t r = line[0];
+            uint8_t g = line[ch >> 1];
+            uint8_t b = line[ch - 1];
+
+            *reinterpret_cast<b16_t*>(dst_p + idx) =
+              b16_t{.b0_8  = static_cast<uint8_t>((r & 0xF8) | (g >> 5)),
+                    .b8_16 = static_cast<uint8_t>(((g << 3) & 0xE0) | (b >> 3))};
+        }
+        break;
+
+    case EL_PIXEL_FORMAT_GRAYSCALE:
+        if (ch == 3)
+            for (uint16_t j = 0; j < n; ++j, idx += step, line += 3)
+                dst_p[idx] = lut_r[(line[0] * 299 + line[1] * 587 + line[2] * 114) / 1000];
+        else
+            for (uint16_t j = 0; j < n; ++j, idx += step) dst_p[idx] = lut_r[line[j]];
+        break;
+
+    default:
+        break;
+    }
+}
+
+ImgConvertPlan::ImgConvertPlan()
+    : _built(false),
+      _src{},
+      _dst{},
+      _canvas{},
+      _interp(EL_PIXEL_INTERP_NEAREST),
+      _ch(0),
+      _elem(0),
+      _plane(0),
+      _norm(nullptr),
+      _row_base(0),
+      _row_step(0),
+      _col_step(0),
+      _tiled(false),
+      _slices(1),
+      _jpeg{},
+      _jpeg_scale(0),
+      _jpeg_buf(nullptr),
+      _fit(EL_PIXEL_FIT_STRETCH),
+      _area_x(0),
+      _area_y(0),
+      _area_w(0),
+      _area_h(0),
+      _lut{},
+      _lut_r5{},
+      _lut_g6{},
+      _lut_b5{},
+      _row_fn(nullptr),
+      _span_fn(nullptr),
+      _pool(nullptr),
+      _xofs(nullptr),
+      _yofs(nullptr),
+      _xtab(nullptr),
+      _ytab(nullptr),
+      _rows(nullptr),
+      _line(nullptr),
+      _buf(nullptr) {}
+
+ImgConvertPlan::~ImgConvertPlan() { release(); }
+
+void ImgConvertPlan::release() {
+    if (_pool) el_free(_pool);
+    if (_jpeg_buf) el_free(_jpeg_buf);
+    if (_norm) el_free(_norm);
+
+    _built      = false;
+    _jpeg_scale = 0;
+    _jpeg_buf   = nullptr;
+    _norm       = nullptr;
+    _row_fn     = nullptr;
+    _span_fn    = nullptr;
+    _pool       = nullptr;
+    _xofs       = nullptr;
+    _yofs       = nullptr;
+    _xtab       = nullptr;
+    _ytab       = nullptr;
+    _rows       = nullptr;
+    _line       = nullptr;
+    _buf        = nullptr;
+}
+
+el_err_code_t ImgConvertPlan::build(const el_img_t*      src,
+                                    const el_img_t*      dst,
+                                    const el_img_lut_t*  lut,
+                                    el_pixel_interp_t    interp,
+                                    el_pixel_fit_t       fit,
+                                    const el_img_norm_t* norm) {
+    release();
+
+    if (!src || !dst || !src->width || !src->height || !dst->width || !dst->height) [[unlikely]]
+        return EL_EINVAL;
+
+    if (dst->format != EL_PIXEL_FORMAT_RGB565 && dst->format != EL_PIXEL_FORMAT_RGB888 &&
+        dst->format != EL_PIXEL_FORMAT_GRAYSCALE && dst->format != EL_PIXEL_FORMAT_RGB888_PLANAR)
+        return EL_ENOTSUP;
+
+    // 565 has no room for normalized channels
+    if (norm && dst->format == EL_PIXEL_FORMAT_RGB565) [[unlikely]]
+        return EL_ENOTSUP;
+
+    el_img_t decoded;
+    if (src->format == EL_PIXEL_FORMAT_JPEG) {
+        auto ret = build_jpeg(src, dst, fit, &decoded);
+        if (ret != EL_OK) return ret;
+        src = &decoded;
+    }
+
+    if (src->format != EL_PIXEL_FORMAT_RGB565 && src->format != EL_PIXEL_FORMAT_RGB888 &&
+        src->format != EL_PIXEL_FORMAT_GRAYSCALE && !is_yuv_format(src->format))
+        return EL_ENOTSUP;
+
+    // planes are located from the image size, planar sources cannot be strided
+    if (!el_img_bpp(src->format) && !is_packed(src)) [[unlikely]]
+        return EL_ENOTSUP;
+
+    // the converted area is a view of the canvas, located in memory coordinates according to the rotation
+    el_img_map_t map;
+    el_img_fit_map(src, dst, fit, &map);
+
+    switch (dst->rotate) {
+    case EL_PIXEL_ROTATE_90:
+        _area_x = dst->height - map.y_offset - map.h;
+        _area_y = map.x_offset;
+        break;
+    case EL_PIXEL_ROTATE_180:
+        _area_x = dst->width - map.x_offset - map.w;
+        _area_y = dst->height - map.y_offset - map.h;
+        break;
+    case EL_PIXEL_ROTATE_270:
+        _area_x = map.y_offset;
+        _area_y = dst->width - map.x_offset - map.w;
+        break;
+    default:
+        _area_x = map.x_offset;
+        _area_y = map.y_offset;
+    }
+    bool transposed = dst->rotate == EL_PIXEL_ROTATE_90 || dst->rotate == EL_PIXEL_ROTATE_270;
+    _area_w         = transposed ? map.h : map.w;
+    _area_h         = transposed ? map.w : map.h;
+
+    uint16_t sw = src->width;
+    uint16_t sh = src->height;
+    uint16_t dw = map.w;
+    uint16_t dh = map.h;
+
+    // same geometry resampling is nearest
+    if (sw == dw && sh == dh) interp = EL_PIXEL_INTERP_NEAREST;
+
+    // destination strides in bytes, rows of a 90 or 270 degrees rotated image are stored as columns, channels of
+    // float and planar destinations are addressed through the plane offset
+    bool    planar = dst->format == EL_PIXEL_FORMAT_RGB888_PLANAR;
+    uint8_t esize  = norm ? sizeof(float) : 1;
+    _elem          = planar ? esize : el_img_bpp(dst->format) * esize;
+    int32_t bpp    = _elem;
+    int32_t pitch  = static_cast<int32_t>(dst->pitch ? dst->pitch : static_cast<size_t>(stored_width(dst)) * _elem);
+    _plane         = planar ? static_cast<size_t>(pitch) * (transposed ? dst->width : dst->height) : esize;
+
+    _src        = *src;
+    _canvas     = *dst;
+    _dst        = *dst;
+    _dst.width  = dw;
+    _dst.height = dh;
+    _dst.pitch  = pitch;
+    _interp     = interp;
+    _fit        = fit;
+    _ch         = (src->format == EL_PIXEL_FORMAT_GRAYSCALE || dst->format == EL_PIXEL_FORMAT_GRAYSCALE) ? 1 : 3;
+
+    _src.data    = nullptr;
+    _canvas.data = nullptr;
+    _dst.data    = nullptr;
+
+    switch (dst->rotate) {
+    case EL_PIXEL_ROTATE_90:
+        _row_base = (dh - 1) * bpp;
+        _row_step = -bpp;
+        _col_step = pitch;
+        break;
+    case EL_PIXEL_ROTATE_180:
+        _row_base = (dh - 1) * pitch + (dw - 1) * bpp;
+        _row_step = -pitch;
+        _col_step = -bpp;
+        break;
+    case EL_PIXEL_ROTATE_270:
+        _row_base = (dw - 1) * pitch;
+        _row_step = bpp;
+        _col_step = -pitch;
+        break;
+    default:
+        _row_base = 0;
+        _row_step = pitch;
+        _col_step = bpp;
+    }
+    _tiled = transposed;
+
+    if (!lut) lut = &IDENTITY_LOOKUP_TABLE;
+    for (uint8_t c = 0; c < 3; ++c) _lut[c] = lut->table[c];
+    for (uint8_t i = 0; i < 32; ++i) {
+        _lut_r5[i] = _lut[0][RGB565_TO_RGB888_LOOKUP_TABLE_5[i]];
+        _lut_b5[i] = _lut[2][RGB565_TO_RGB888_LOOKUP_TABLE_5[i]];
+    }
+    for (uint8_t i = 0; i < 64; ++i) _lut_g6[i] = _lut[1][RGB565_TO_RGB888_LOOKUP_TABLE_6[i]];
+
+    // normalized channels are looked up like the lut, which is folded into the tables
+    if (norm) {
+        _norm = static_cast<float*>(el_malloc(sizeof(float) * 3 * 256));
+        if (!_norm) [[unlikely]]
+            return EL_ENOMEM;
+
+        for (uint8_t c = 0; c < 3; ++c) {
+            float k = norm->std[c] != 0.f ? 1.f / (255.f * norm->std[c]) : 0.f;
+            float b = norm->std[c] != 0.f ? -norm->mean[c] / norm->std[c] : 0.f;
+            for (uint16_t i = 0; i < 256; ++i) _norm[c * 256 + i] = _lut[c][i] * k + b;
+        }
+    }
+
+    // large destinations are split in slices of rows (whole tiles when transposing) converted in parallel
+    _slices = 1;
+#if CONFIG_EL_CV_THREADS > 1
+    if (static_cast<uint32_t>(dw) * dh >= CONFIG_EL_CV_THREADS_MIN_PIXELS) {
+        uint16_t unit = _tiled ? ROTATE_TILE_SIZE : 1;
+        _slices       = EL_MIN((dh + unit - 1) / unit, CONFIG_EL_CV_THREADS);
+    }
+#endif
+
+    if (interp == EL_PIXEL_INTERP_NEAREST) {
+        _pool = static_cast<uint8_t*>(el_malloc(sizeof(uint32_t) * (dw + dh)));
+        if (!_pool) [[unlikely]]
+            return EL_ENOMEM;
+
+        _xofs = reinterpret_cast<uint32_t*>(_pool);
+        _yofs = _xofs + dw;
+
+        // yuv sources are addressed by pixel coordinates, the sample offsets depend on the layout
+        bool     yuv    = is_yuv_format(src->format);
+        uint32_t sbpp   = yuv ? 1 : el_img_bpp(src->format);
+        uint32_t stride = yuv ? 1 : el_img_pitch(src);
+        uint32_t beta_w = (static_cast<uint32_t>(sw) << 16) / dw;
+        uint32_t beta_h = (static_cast<uint32_t>(sh) << 16) / dh;
+
+        for (uint16_t j = 0; j < dw; ++j) _xofs[j] = ((j * beta_w) >> 16) * sbpp;
+        for (uint16_t i = 0; i < dh; ++i) _yofs[i] = ((i * beta_h) >> 16) * stride;
+
+        _row_fn = select_nearest_row(src->format, dst->format, norm != nullptr);
+#if CONFIG_EL_CV_SIMD
+        if (lut == &IDENTITY_LOOKUP_TABLE && !norm && sw == dw && sh == dh && dst->rotate == EL_PIXEL_ROTATE_0)
+            _span_fn = simd::select(src->format, dst->format);
+#endif
+    } else {
+        size_t n     = static_cast<size_t>(dw) * _ch;
+        size_t lines = _tiled ? ROTATE_TILE_SIZE : 1;
+        size_t size  = sizeof(resize_coeff_t) * (dw + dh) +
+                      (n * sizeof(uint32_t) + n * lines + static_cast<size_t>(sw) * _ch) * _slices;
+
+        _pool = static_cast<uint8_t*>(el_malloc(size));
+        if (!_pool) [[unlikely]]
+            return EL_ENOMEM;
+
+        // coefficient tables, then per slice Q8 rows (2 x uint16 for bilinear, 1 x uint32 accumulator for area),
+        // output lines (a tile high when rotating by 90 or 270 degrees) and decode row
+        _xtab = reinterpret_cast<resize_coeff_t*>(_pool);
+        _ytab = _xtab + dw;
+        _rows = reinterpret_cast<uint8_t*>(_ytab + dh);
+        _line = _rows + n * sizeof(uint32_t) * _slices;
+        _buf  = _line + n * lines * _slices;
+
+        build_resize_coeff(_xtab, sw, dw, interp);
+        build_resize_coeff(_ytab, sh, dh, interp);
+    }
+
+    _built = true;
+
+    return EL_OK;
+}
+
+// the decoded size is picked from the destination (or its letterboxed area), the frame header is then expected to
+// match on every execution
+el_err_code_t ImgConvertPlan::build_jpeg(const el_img_t* src,
+                                         const el_img_t* dst,
+                                         el_pixel_fit_t  fit,
+                                         el_img_t*       decoded) {
+    if (!src->data) [[unlikely]]
+        return EL_EINVAL;
+
+    el_jpeg_info_t info;
+    auto           ret = el_jpeg_get_info(src->data, src->size, &info);
+    if (ret != EL_OK) return ret;
+
+    el_img_t frame = *src;
+    frame.width    = info.width;
+    frame.height   = info.height;
+
+    el_img_map_t map;
+    el_img_fit_map(&frame, dst, fit, &map);
+
+    uint8_t scale = 8;
+    while (scale > 1 && ((info.width + scale - 1) / scale < map.w || (info.height + scale - 1) / scale < map.h))
+        scale >>= 1;
+
+    bool gray = info.components == 1 || dst->format == EL_PIXEL_FORMAT_GRAYSCALE;
+
+    *decoded        = el_img_t{};
+    decoded->width  = (info.width + scale - 1) / scale;
+    decoded->height = (info.height + scale - 1) / scale;
+    decoded->format = gray ? EL_PIXEL_FORMAT_GRAYSCALE : EL_PIXEL_FORMAT_RGB888;
+    decoded->rotate = EL_PIXEL_ROTATE_0;
+    decoded->size   = static_cast<size_t>(decoded->width) * decoded->height * (gray ? 1 : 3);
+    decoded->data   = static_cast<uint8_t*>(el_malloc(decoded->size));
+    if (!decoded->data) [[unlikely]]
+        return EL_ENOMEM;
+
+    _jpeg       = *src;
+    _jpeg.data  = nullptr;
+    _jpeg_scale = scale;
+    _jpeg_buf   = decoded->data;
+
+    return EL_OK;
+}
+
+bool ImgConvertPlan::is_built_for(const el_img_t* src, const el_img_t* dst) const {
+    const el_img_t& s = _jpeg_scale ? _jpeg : _src;
+    return _built && src->width == s.width && src->height == s.height && src->format == s.format &&
+           el_img_pitch(src) == el_img_pitch(&s) && dst->width == _canvas.width &&
+           dst->height == _canvas.height && dst->format == _canvas.format && dst->rotate == _canvas.rotate &&
+           el_img_pitch(dst) == el_img_pitch(&_canvas);
+}
+
+el_err_code_t ImgConvertPlan::execute(const el_img_t* src, el_img_t* dst) {
+    if (!src || !src->data || !dst || !dst->data) [[unlikely]]
+        return EL_EINVAL;
+
+    if (!is_built_for(src, dst)) [[unlikely]]
+        return EL_EINVAL;
+
+    el_img_t decoded;
+    if (_jpeg_scale) {
+        decoded      = _src;
+        decoded.data = _jpeg_buf;
+        auto ret     = el_jpeg_decode(src->data, src->size, _jpeg_scale, &decoded);
+        if (ret != EL_OK) return ret;
+        src = &decoded;
+    }
+
+    // the pad is repainted on every frame, a destination such as a model input tensor is reused as scratch between
+    // executions and the border written last time is not known to be intact
+    if (_fit == EL_PIXEL_FIT_LETTERBOX) fill_pad(dst->data);
+
+    el_img_t area = _dst;
+    area.data     = dst->data + _area_y * el_img_pitch(&_dst) + _area_x * _elem;
+    area.size     = (_area_h - 1) * el_img_pitch(&_dst) + _area_w * _elem;
+
+    auto convert = [&](uint8_t slice) {
+        uint16_t first = slice_row(slice);
+        uint16_t last  = slice_row(slice + 1);
+        if (_interp == EL_PIXEL_INTERP_NEAREST)
+            execute_nearest(src, &area, first, last);
+        else
+            execute_resample(src, &area, slice, first, last);
+    };
+
+#if CONFIG_EL_CV_THREADS > 1
+    if (_slices > 1) {
+        parallel::WorkerPool::instance().run(_slices, convert);
+        return EL_OK;
+    }
+#endif
+    convert(0);
+
+    return EL_OK;
+}
+
+// first destination row of a slice, slices start on tile boundaries so the tiled loops never straddle two of them
+uint16_t ImgConvertPlan::slice_row(uint8_t slice) const {
+    uint16_t dh = _dst.height;
+    if (slice >= _slices) return dh;
+
+    uint16_t unit = _tiled ? ROTATE_TILE_SIZE : 1;
+    return static_cast<uint32_t>((dh + unit - 1) / unit) * slice / _slices * unit;
+}
+
+void ImgConvertPlan::fill_pad(uint8_t* dst) const {
+    uint8_t bpp    = _elem;
+    size_t  pitch  = el_img_pitch(&_dst);
+    bool    planar = _canvas.format == EL_PIXEL_FORMAT_RGB888_PLANAR;
+    uint8_t px[3 * sizeof(float)];
+
+    // the pad pixel as stored, or its channels one after the other when every plane is filled on its own
+    switch (_canvas.format) {
+    case EL_PIXEL_FORMAT_RGB565:
+        // 565 destinations are stored without the lut
+        *reinterpret_cast<b16_t*>(px) =
+          b16_t{.b0_8  = static_cast<uint8_t>((LETTERBOX_PAD_VALUE & 0xF8) | (LETTERBOX_PAD_VALUE >> 5)),
+                .b8_16 = static_cast<uint8_t>(((LETTERBOX_PAD_VALUE << 3) & 0xE0) | (LETTERBOX_PAD_VALUE >> 3))};
+        break;
+    default:
+        for (uint8_t c = 0; c < (_canvas.format == EL_PIXEL_FORMAT_GRAYSCALE ? 1 : 3); ++c) {
+            if (_norm)
+                store_channel<true>(px + c * sizeof(float), _lut[c], _norm + c * 256, LETTERBOX_PAD_VALUE);
+            else
+                store_channel<false>(px + c, _lut[c], _norm, LETTERBOX_PAD_VALUE);
+        }
+    }
+
+    auto fill = [&](uint8_t* base, const uint8_t* pad, uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+        for (uint16_t i = 0; i < h; ++i) {
+            uint8_t* p = base + (y + i) * pitch + x * bpp;
+            if (bpp == 1)
+                memset(p, pad[0], w);
+            else
+                for (uint16_t j = 0; j < w; ++j, p += bpp) memcpy(p, pad, bpp);
+        }
+    };
+
+    // bands above and below the area, then the columns left and right of it, in every plane
+    uint16_t cw = stored_width(&_canvas);
+    uint16_t ch = _tiled ? _canvas.width : _canvas.height;
+    for (uint8_t k = 0; k < (planar ? 3 : 1); ++k) {
+        uint8_t*       base = dst + k * (planar ? _plane : 0);
+        const uint8_t* pad  = px + k * bpp;
+        fill(base, pad, 0, 0, cw, _area_y);
+        fill(base, pad, 0, _area_y + _area_h, cw, ch - _area_y - _area_h);
+        fill(base, pad, 0, _area_y, _area_x, _area_h);
+        fill(base, pad, _area_x + _area_w, _area_y, cw - _area_x - _area_w, _area_h);
+    }
+}
+
+template <el_pixel_format_t S, el_pixel_format_t D, bool F>
+void ImgConvertPlan::nearest_row(const ImgConvertPlan* plan,
+                                 const uint8_t* const* src_rows,
+                                 uint8_t*              dst,
+                                 int32_t               idx,
+                                 uint16_t              begin,
+                                 uint16_t              end) {
+    const uint32_t* xofs  = plan->_xofs;
+    const int32_t   step  = plan->_col_step;
+    const size_t    plane = plan->_plane;
+    const float*    norm  = plan->_norm;
+    const uint8_t*  s     = src_rows[0];
+    const uint8_t*  lut_r = plan->_lut[0];
+    const uint8_t*  lut_g = plan->_lut[1];
+    const uint8_t*  lut_b = plan->_lut[2];
+
+    // float and planar destinations store every channel on its own, plane bytes after the previous one
+    constexpr bool split = D == EL_PIXEL_FORMAT_RGB888_PLANAR || (D == EL_PIXEL_FORMAT_RGB888 && F);
+
+    for (uint16_t j = begin; j < end; ++j, idx += step) {
+        const uint8_t* px = s + xofs[j];
+
+        if constexpr (S == EL_PIXEL_FORMAT_RGB565 && D == EL_PIXEL_FORMAT_RGB565) {
+            *reinterpret_cast<b16_t*>(dst + idx) = *reinterpret_cast<const b16_t*>(px);
+        } else if constexpr (S == EL_PIXEL_FORMAT_RGB565 && D == EL_PIXEL_FORMAT_RGB888 && !F) {
+            // the lut is folded into the 5/6 bit expansion tables
+            *reinterpret_cast<b24_t*>(dst + idx) =
+              b24_t{.b0_8   = plan->_lut_r5[(px[0] & 0xF8) >> 3],
+                    .b8_16  = plan->_lut_g6[((px[0] & 0x07) << 3) | ((px[1] & 0xE0) >> 5)],
+                    .b16_24 = plan->_lut_b5[px[1] & 0x1F]};
+        } else if constexpr (S == EL_PIXEL_FORMAT_GRAYSCALE || (is_yuv_format(S) && D == EL_PIXEL_FORMAT_GRAYSCALE)) {
+            // grayscale from yuv only reads the luma samples
+            uint8_t c = is_yuv_format(S) ? s[xofs[j] * yuv_y_step(S)] : *px;
+            if constexpr (split) {
+                store_channel<F>(dst + idx, lut_r, norm, c);
+                store_channel<F>(dst + idx + plane, lut_g, norm + 256, c);
+                store_channel<F>(dst + idx + plane * 2, lut_b, norm + 512, c);
+            } else if constexpr (D == EL_PIXEL_FORMAT_GRAYSCALE && F)
+                store_channel<F>(dst + idx, lut_r, norm, c);
+            else if constexpr (D == EL_PIXEL_FORMAT_RGB888)
+                *reinterpret_cast<b24_t*>(dst + idx) = b24_t{.b0_8 = lut_r[c], .b8_16 = lut_g[c], .b16_24 = lut_b[c]};
+            else if constexpr (D == EL_PIXEL_FORMAT_RGB565)
+                *reinterpret_cast<b16_t*>(dst + idx) =
+                  b16_t{.b0_8  = static_cast<uint8_t>((c & 0xF8) | (c >> 5)),
+                        .b8_16 = static_cast<uint8_t>(((c << 3) & 0xE0) | (c >> 3))};
+            else
+                dst[idx] = lut_r[c];
+        } else {
+            uint8_t r = 0;
+            uint8_t g = 0;
+            uint8_t b = 0;
+
+            if constexpr (S == EL_PIXEL_FORMAT_RGB888) {
+                r = px[0];
+                g = px[1];
+                b = px[2];
+            } else if constexpr (S == EL_PIXEL_FORMAT_RGB565) {
+                r = RGB565_TO_RGB888_LOOKUP_TABLE_5[(px[0] & 0xF8) >> 3];
+                g = RGB565_TO_RGB888_LOOKUP_TABLE_6[((px[0] & 0x07) << 3) | ((px[1] & 0xE0) >> 5)];
+                b = RGB565_TO_RGB888_LOOKUP_TABLE_5[px[1] & 0x1F];
+            } else {
+                uint8_t  rgb[3];
+                uint32_t x = xofs[j];
+                uint32_t c = (x >> 1) * yuv_c_step(S);
+                yuv_to_rgb(s[x * yuv_y_step(S)], src_rows[1][c], src_rows[2][c], rgb);
+                r = rgb[0];
+                g = rgb[1];
+                b = rgb[2];
+            }
+
+            if constexpr (split) {
+                store_channel<F>(dst + idx, lut_r, norm, r);
+                store_channel<F>(dst + idx + plane, lut_g, norm + 256, g);
+                store_channel<F>(dst + idx + plane * 2, lut_b, norm + 512, b);
+            } else if constexpr (D == EL_PIXEL_FORMAT_RGB888)
+                *reinterpret_cast<b24_t*>(dst + idx) = b24_t{.b0_8 = lut_r[r], .b8_16 = lut_g[g], .b16_24 = lut_b[b]};
+            else if constexpr (D == EL_PIXEL_FORMAT_RGB565)
+                *reinterpret_cast<b16_t*>(dst + idx) =
+                  b16_t{.b0_8  = static_cast<uint8_t>((r & 0xF8) | (g >> 5)),
+                        .b8_16 = static_cast<uint8_t>(((g << 3) & 0xE0) | (b >> 3))};
+            else
+                store_channel<F>(dst + idx, lut_r, norm, (r * 299 + g * 587 + b * 114) / 1000);
+        }
+    }
+}
+
+ImgConvertPlan::RowFn ImgConvertPlan::select_nearest_row(el_pixel_format_t src_format,
+                                                         el_pixel_format_t dst_format,
+                                                         bool              normalized) {
+#define EL_CV_SELECT_ROW(S)                                                                                   \
+    switch (dst_format) {                                                                                     \
+    case EL_PIXEL_FORMAT_RGB888:                                                                              \
+        return normalized ? &nearest_row<S, EL_PIXEL_FORMAT_RGB888, true>                                     \
+                          : &nearest_row<S, EL_PIXEL_FORMAT_RGB888, false>;                                   \
+    case EL_PIXEL_FORMAT_RGB565:                                                                              \
+        return &nearest_row<S, EL_PIXEL_FORMAT_RGB565, false>;                                                \
+    case EL_PIXEL_FORMAT_GRAYSCALE:                                                                           \
+        return normalized ? &nearest_row<S, EL_PIXEL_FORMAT_GRAYSCALE, true>                                  \
+                          : &nearest_row<S, EL_PIXEL_FORMAT_GRAYSCALE, false>;                                \
+    case EL_PIXEL_FORMAT_RGB888_PLANAR:                                                                       \
+        return normalized ? &nearest_row<S, EL_PIXEL_FORMAT_RGB888_PLANAR, true>                              \
+                          : &nearest_row<S, EL_PIXEL_FORMAT_RGB888_PLANAR, false>;                            \
+    default:                                                                                                  \
+        return nullptr;                                                                                       \
+    }
+
+    switch (src_format) {
+    case EL_PIXEL_FORMAT_RGB888:
+        EL_CV_SELECT_ROW(EL_PIXEL_FORMAT_RGB888)
+    case EL_PIXEL_FORMAT_RGB565:
+        EL_CV_SELECT_ROW(EL_PIXEL_FORMAT_RGB565)
+    case EL_PIXEL_FORMAT_GRAYSCALE:
+        EL_CV_SELECT_ROW(EL_PIXEL_FORMAT_GRAYSCALE)
+    case EL_PIXEL_FORMAT_YUV422:
+        EL_CV_SELECT_ROW(EL_PIXEL_FORMAT_YUV422)
+    case EL_PIXEL_FORMAT_YUYV:
+        EL_CV_SELECT_ROW(EL_PIXEL_FORMAT_YUYV)
+    case EL_PIXEL_FORMAT_UYVY:
+        EL_CV_SELECT_ROW(EL_PIXEL_FORMAT_UYVY)
+    case EL_PIXEL_FORMAT_NV12:
+        EL_CV_SELECT_ROW(EL_PIXEL_FORMAT_NV12)
+    case EL_PIXEL_FORMAT_NV21:
+        EL_CV_SELECT_ROW(EL_PIXEL_FORMAT_NV21)
+    default:
+        return nullptr;
+    }
+
+#undef EL_CV_SELECT_ROW
+}
+
+void ImgConvertPlan::execute_nearest(const el_img_t* src, el_img_t* dst, uint16_t first, uint16_t last) const {
+    if (_span_fn) {
+        size_t sp = el_img_pitch(src);
+        size_t dp = el_img_pitch(dst);
+        if (is_packed(src) && is_packed(dst))
+            _span_fn(src->data + first * sp, dst->data + first * dp, static_cast<size_t>(_src.width) * (last - first));
+        else
+            for (uint16_t i = first; i < last; ++i) _span_fn(src->data + i * sp, dst->data + i * dp, _src.width);
+        return;
+    }
+
+    uint16_t dw   = _dst.width;
+    uint16_t tile = _tiled ? ROTATE_TILE_SIZE : dw;
+    bool     yuv  = is_yuv_format(_src.format);
+
+    const uint8_t* rows[3]{};
+
+    // unrotated conversions are a single tile per row, others are walked tile by tile
+    for (uint16_t i0 = first; i0 < last; i0 += tile) {
+        uint16_t i1 = EL_MIN(static_cast<uint16_t>(last - i0), tile) + i0;
+        for (uint16_t j0 = 0; j0 < dw; j0 += tile) {
+            uint16_t j1  = EL_MIN(static_cast<uint16_t>(dw - j0), tile) + j0;
+            int32_t  idx = _row_base + i0 * _row_step + j0 * _col_step;
+            for (uint16_t i = i0; i < i1; ++i, idx += _row_step) {
+                if (yuv)
+                    locate_yuv_row(src, _yofs[i], rows);
+                else
+                    rows[0] = src->data + _yofs[i];
+                _row_fn(this, rows, dst->data, idx, j0, j1);
+            }
+        }
+    }
+}
+
+void ImgConvertPlan::execute_resample(
+  const el_img_t* src, el_img_t* dst, uint8_t slice, uint16_t first, uint16_t last) const {
+    uint16_t dw    = _dst.width;
+    uint8_t  ch    = _ch;
+    size_t   n     = static_cast<size_t>(dw) * ch;
+    uint16_t lines = _tiled ? ROTATE_TILE_SIZE : 1;
+
+    // every slice works in its own scratch rows, output lines and decode row
+    uint8_t* rows  = _rows + slice * n * sizeof(uint32_t);
+    uint8_t* lbuf  = _line + slice * n * lines;
+    uint8_t* buf   = _buf + slice * static_cast<size_t>(_src.width) * ch;
+
+    // output lines are buffered and stored once a tile high when rotating by 90 or 270 degrees
+    auto emit = [&](uint16_t i) {
+        uint16_t k = i % lines;
+        if (k == lines - 1 || i == last - 1) store_lines(dst->data, lbuf, i - k, k + 1);
+    };
+
+    if (_interp == EL_PIXEL_INTERP_BILINEAR) {
+        uint16_t* h[2]   = {reinterpret_cast<uint16_t*>(rows), reinterpret_cast<uint16_t*>(rows) + n};
+        int32_t   tag[2] = {-1, -1};
+
+        // horizontally filtered rows are cached, each source row is filtered at most once for a downscale
+        auto h_row = [&](uint16_t y, const uint16_t* keep) -> const uint16_t* {
+            if (tag[0] == y) return h[0];
+            if (tag[1] == y) return h[1];
+            uint8_t slot = keep == h[0] ? 1 : keep == h[1] ? 0 : (tag[0] < tag[1] ? 0 : 1);
+            auto    s    = fetch_src_row(src, y, ch, buf);
+            if (ch == 3)
+                h_bilinear<3>(s, _xtab, h[slot], dw);
+            else
+                h_bilinear<1>(s, _xtab, h[slot], dw);
+            tag[slot] = y;
+            return h[slot];
+        };
+
+        for (uint16_t i = first; i < last; ++i) {
+            const uint16_t* r0   = h_row(_ytab[i].index, nullptr);
+            const uint16_t* r1   = h_row(_ytab[i].index + _ytab[i].span, r0);
+            uint32_t        w1   = _ytab[i].coeff;
+            uint32_t        w0   = 256u - w1;
+            uint8_t*        line = lbuf + (i % lines) * n;
+            for (size_t k = 0; k < n; ++k) line[k] = static_cast<uint8_t>((r0[k] * w0 + r1[k] * w1 + 32768u) >> 16);
+            emit(i);
+        }
+    } else {
+        uint32_t* acc = reinterpret_cast<uint32_t*>(rows);
+
+        for (uint16_t i = first; i < last; ++i) {
+            memset(acc, 0, n * sizeof(uint32_t));
+            for (uint16_t y = _ytab[i].index, e = _ytab[i].index + _ytab[i].span; y < e; ++y) {
+                auto s = fetch_src_row(src, y, ch, buf);
+                if (ch == 3)
+                    h_area<3>(s, _xtab, acc, dw);
+                else
+                    h_area<1>(s, _xtab, acc, dw);
+            }
+            // acc <= (255 << 8) * span and coeff <= 65536 / span, the product fits in 32 bits
+            uint8_t* line = lbuf + (i % lines) * n;
+            for (size_t k = 0; k < n; ++k)
+                line[k] = static_cast<uint8_t>((acc[k] * _ytab[i].coeff + (1u << 23)) >> 24);
+            emit(i);
+        }
+    }
+}
+
+// stores count buffered output lines starting at destination row first, column tile by column tile
+void ImgConvertPlan::store_lines(uint8_t* dst, const uint8_t* line, uint16_t first, uint16_t count) const {
+    uint16_t dw   = _dst.width;
+    size_t   n    = static_cast<size_t>(dw) * _ch;
+    uint16_t tile = _tiled ? ROTATE_TILE_SIZE : dw;
+
+    for (uint16_t j0 = 0; j0 < dw; j0 += tile) {
+        uint16_t w   = EL_MIN(static_cast<uint16_t>(dw - j0), tile);
+        int32_t  idx = _row_base + first * _row_step + j0 * _col_step;
+        for (uint16_t r = 0; r < count; ++r, idx += _row_step)
+            store_dst_row(dst, _dst.format, w, idx, _col_step, line + r * n + j0 * _ch, _ch, _lut, _plane, _norm);
+    }
+}
+
+// pyramid levels are filtered on their rows as stored in memory, whatever their rotation
+static el_img_t stored_layout(const el_img_t* img) {
+    bool     transposed = img->rotate == EL_PIXEL_ROTATE_90 || img->rotate == EL_PIXEL_ROTATE_270;
+    el_img_t view       = *img;
+    view.width          = transposed ? img->height : img->width;
+    view.height         = transposed ? img->width : img->height;
+    view.rotate         = EL_PIXEL_ROTATE_0;
+    return view;
+}
+
+static uint16_t pyramid_side(uint16_t side, float ratio) {
+    uint16_t next = ratio == 2.f ? side >> 1 : static_cast<uint16_t>(static_cast<float>(side) / ratio);
+    return next ? next : 1;
+}
+
+// 2 x 2 box average, an odd last row or column of src is dropped
+template <uint8_t CH> static void pyramid_down_2x(const el_img_t* src, el_img_t* dst) {
+    size_t sp = el_img_pitch(src);
+    size_t dp = el_img_pitch(dst);
+
+    for (uint16_t y = 0; y < dst->height; ++y) {
+        const uint8_t* s0 = src->data + 2 * y * sp;
+        const uint8_t* s1 = s0 + sp;
+        uint8_t*       d  = dst->data + y * dp;
+        for (uint16_t x = 0; x < dst->width; ++x, s0 += 2 * CH, s1 += 2 * CH, d += CH)
+            for (uint8_t c = 0; c < CH; ++c) d[c] = (s0[c] + s0[c + CH] + s1[c] + s1[c + CH] + 2) >> 2;
+    }
+}
+
+EL_ATTR_WEAK size_t el_img_pyramid_size(const el_img_t* base, uint8_t count, float ratio) {
+    if (!base || !count || !(ratio > 1.f)) [[unlikely]]
+        return 0;
+
+    uint8_t  bpp  = el_img_bpp(base->format);
+    uint16_t w    = base->width;
+    uint16_t h    = base->height;
+    size_t   size = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        size = ((size + 3) & ~static_cast<size_t>(3)) + static_cast<size_t>(w) * h * bpp;
+        w    = pyramid_side(w, ratio);
+        h    = pyramid_side(h, ratio);
+    }
+    return size;
+}
+
+EL_ATTR_WEAK el_err_code_t el_img_pyramid(const el_img_t*   src,
+                                          el_img_t*         levels,
+                                          uint8_t           count,
+                                          uint8_t*          buf,
+                                          size_t            size,
+                                          float             ratio,
+                                          el_pixel_interp_t interp) {
+    if (!src || !src->data || !levels || !count || !buf || !(ratio > 1.f)) [[unlikely]]
+        return EL_EINVAL;
+
+    el_pixel_format_t format = levels[0].format;
+    if (format != EL_PIXEL_FORMAT_RGB888 && format != EL_PIXEL_FORMAT_RGB565 && format != EL_PIXEL_FORMAT_GRAYSCALE)
+        return EL_ENOTSUP;
+
+    if (!levels[0].width || !levels[0].height || el_img_pyramid_size(&levels[0], count, ratio) > size) [[unlikely]]
+        return EL_EINVAL;
+
+    size_t offset = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        el_img_t& level = levels[i];
+        if (i) {
+            level.width  = pyramid_side(levels[i - 1].width, ratio);
+            level.height = pyramid_side(levels[i - 1].height, ratio);
+            level.format = format;
+            level.rotate = levels[0].rotate;
+        }
+        offset      = (offset + 3) & ~static_cast<size_t>(3);
+        level.data  = buf + offset;
+        level.size  = static_cast<size_t>(level.width) * level.height * el_img_bpp(format);
+        level.pitch = 0;
+        offset += level.size;
+    }
+
+    auto ret = el_img_convert(src, &levels[0], nullptr, interp);
+    if (ret != EL_OK) return ret;
+
+    // every level is filtered from the previous one, only the first reads the full source
+    for (uint8_t i = 1; i < count; ++i) {
+        el_img_t prev  = stored_layout(&levels[i - 1]);
+        el_img_t level = stored_layout(&levels[i]);
+
+        if (ratio == 2.f && format == EL_PIXEL_FORMAT_RGB888) {
+            pyramid_down_2x<3>(&prev, &level);
+        } else if (ratio == 2.f && format == EL_PIXEL_FORMAT_GRAYSCALE) {
+            pyramid_down_2x<1>(&prev, &level);
+        } else {
+            ImgConvertPlan plan;
+            ret = plan.build(&prev, &level, nullptr, EL_PIXEL_INTERP_AREA);
+            if (ret == EL_OK) ret = plan.execute(&prev, &level);
+            if (ret != EL_OK) return ret;
+        }
     }
+
+    return EL_OK;
 }
 
 #if CONFIG_EL_LIB_JPEGENC
 
-EL_ATTR_WEAK el_err_code_t rgb_to_jpeg(const el_img_t* src, el_img_t* dst) {
-    static JPEG   jpg;
-    JPEGENCODE    jpe;
-    int           rc            = 0;
-    el_err_code_t err           = EL_OK;
-    int           iMCUCount     = 0;
-    int           pitch         = 0;
-    int           bytesPerPixel = 0;
-    int           pixelFormat   = 0;
-    EL_ASSERT(src->format == EL_PIXEL_FORMAT_GRAYSCALE || src->format == EL_PIXEL_FORMAT_RGB565 ||
-              src->format == EL_PIXEL_FORMAT_RGB888);
-    if (src->format == EL_PIXEL_FORMAT_GRAYSCALE) {
+namespace jpeg {
+
+struct sink_context_t {
+    el_jpeg_sink_t sink;
+    void*          user;
+    size_t         size;
+    el_err_code_t  err;
+};
+
+// the encoder is opened in its file mode, the "file name" it hands back on open is the sink context
+static void* sink_open(const char* name) { return const_cast<char*>(name); }
+
+static int32_t sink_write(JPEGFILE* file, uint8_t* buf, int32_t len) {
+    auto* ctx = static_cast<sink_context_t*>(file->fHandle);
+    if (ctx->err != EL_OK) return 0;
+
+    ctx->err = ctx->sink(buf, static_cast<size_t>(len), ctx->user);
+    if (ctx->err != EL_OK) return 0;
+
+    ctx->size += len;
+    return len;
+}
+
+struct buffer_sink_t {
+    uint8_t* data;
+    size_t   capacity;
+    size_t   size;
+};
+
+static el_err_code_t buffer_write(const uint8_t* data, size_t size, void* user) {
+    auto* buf = static_cast<buffer_sink_t*>(user);
+    if (buf->size + size > buf->capacity) [[unlikely]]
+        return EL_EIO;
+
+    memcpy(buf->data + buf->size, data, size);
+    buf->size += size;
+    return EL_OK;
+}
+
+}  // namespace jpeg
+
+el_err_code_t el_img_encode_jpeg(
+  const el_img_t* src, const el_jpeg_config_t* config, el_jpeg_sink_t sink, void* user, size_t* size) {
+    if (!src || !src->data || !src->width || !src->height || !sink) [[unlikely]]
+        return EL_EINVAL;
+
+    int bytesPerPixel = 0;
+    int pixelFormat   = 0;
+    switch (src->format) {
+    case EL_PIXEL_FORMAT_GRAYSCALE:
         bytesPerPixel = 1;
         pixelFormat   = JPEG_PIXEL_GRAYSCALE;
-    } else if (src->format == EL_PIXEL_FORMAT_RGB565) {
+        break;
+    case EL_PIXEL_FORMAT_RGB565:
         bytesPerPixel = 2;
         pixelFormat   = JPEG_PIXEL_RGB565;
-    } else if (src->format == EL_PIXEL_FORMAT_RGB888) {
+        break;
+    case EL_PIXEL_FORMAT_RGB888:
         bytesPerPixel = 3;
         pixelFormat   = JPEG_PIXEL_RGB888;
+        break;
+    default:
+        return EL_ENOTSUP;
     }
-    pitch = src->width * bytesPerPixel;
-    rc    = jpg.open(dst->data, dst->size);
-    if (rc != JPEG_SUCCESS) {
-        err = EL_EIO;
-        goto exit;
-    }
-    rc = jpg.encodeBegin(&jpe, src->width, src->height, pixelFormat, JPEG_SUBSAMPLE_444, JPEG_Q_LOW);
-    if (rc != JPEG_SUCCESS) {
-        err = EL_EIO;
-        goto exit;
-    }
-    iMCUCount = ((src->width + jpe.cx - 1) / jpe.cx) * ((src->height + jpe.cy - 1) / jpe.cy);
-    for (int i = 0; i < iMCUCount && rc == JPEG_SUCCESS; i++) {
-        rc = jpg.addMCU(&jpe, &src->data[jpe.x * bytesPerPixel + jpe.y * src->width * bytesPerPixel], pitch);
+
+    // the grayscale path encodes 8x8 blocks only
+    uint8_t quality   = config ? config->quality : EL_JPEG_QUALITY_LOW;
+    uint8_t subsample = config && src->format != EL_PIXEL_FORMAT_GRAYSCALE && config->subsample == EL_JPEG_SUBSAMPLE_420
+                          ? JPEG_SUBSAMPLE_420
+                          : JPEG_SUBSAMPLE_444;
+
+    // the encoder state holds its 2 KiB output chunk, it lives on the heap for the time of one encoding together
+    // with a block the MCUs crossing the right or bottom edge are copied to, the encoder reads whole MCUs
+    constexpr size_t edge_pitch = 16 * 3;
+    auto*            jpg        = static_cast<JPEG*>(el_malloc(sizeof(JPEG) + edge_pitch * 16));
+    if (!jpg) [[unlikely]]
+        return EL_ENOMEM;
+    uint8_t* edge = reinterpret_cast<uint8_t*>(jpg + 1);
+
+    jpeg::sink_context_t ctx{.sink = sink, .user = user, .size = 0, .err = EL_OK};
+    JPEGENCODE           jpe;
+    el_err_code_t        err   = EL_OK;
+    int                  pitch = static_cast<int>(el_img_pitch(src));
+    int                  rc    = jpg->open(
+      reinterpret_cast<const char*>(&ctx), jpeg::sink_open, nullptr, nullptr, jpeg::sink_write, nullptr);
+    if (rc == JPEG_SUCCESS) rc = jpg->encodeBegin(&jpe, src->width, src->height, pixelFormat, subsample, quality);
+    if (rc == JPEG_SUCCESS) {
+        int iMCUCount = ((src->width + jpe.cx - 1) / jpe.cx) * ((src->height + jpe.cy - 1) / jpe.cy);
+        for (int i = 0; i < iMCUCount && rc == JPEG_SUCCESS && ctx.err == EL_OK; i++) {
+            uint8_t* mcu = &src->data[jpe.x * bytesPerPixel + jpe.y * pitch];
+            if (jpe.x + jpe.cx <= src->width && jpe.y + jpe.cy <= src->height) {
+                rc = jpg->addMCU(&jpe, mcu, pitch);
+                continue;
+            }
+            // the edge pixels are replicated over the part of the MCU outside the image
+            int w = EL_MIN(jpe.cx, src->width - jpe.x) * bytesPerPixel;
+            int h = EL_MIN(jpe.cy, src->height - jpe.y);
+            for (int r = 0; r < jpe.cy; ++r) {
+                uint8_t* row = edge + r * edge_pitch;
+                memcpy(row, mcu + EL_MIN(r, h - 1) * pitch, w);
+                for (int c = w; c < jpe.cx * bytesPerPixel; ++c) row[c] = row[c - bytesPerPixel];
+            }
+            rc = jpg->addMCU(&jpe, edge, edge_pitch);
+        }
     }
-    if (rc != JPEG_SUCCESS) {
+    if (rc == JPEG_SUCCESS && ctx.err == EL_OK) jpg->close();
+
+    if (ctx.err != EL_OK)
+        err = ctx.err;
+    else if (rc != JPEG_SUCCESS)
         err = EL_EIO;
-        goto exit;
-    }
-    dst->size = jpg.close();
+    else if (size)
+        *size = ctx.size;
+
+    el_free(jpg);
 
-exit:
     return err;
 }
 
+EL_ATTR_WEAK el_err_code_t rgb_to_jpeg(const el_img_t* src, el_img_t* dst) {
+    jpeg::buffer_sink_t buf{.data = dst->data, .capacity = dst->size, .size = 0};
+
+    auto ret = el_img_encode_jpeg(src, nullptr, jpeg::buffer_write, &buf);
+    if (ret == EL_OK) dst->size = buf.size;
+
+    return ret;
+}
+
+#else
+
+EL_ATTR_WEAK el_err_code_t el_img_encode_jpeg(
+  const el_img_t* src, const el_jpeg_config_t* config, el_jpeg_sink_t sink, void* user, size_t* size) {
+    return EL_ENOTSUP;
+}
+
 #endif
 
-// TODO: need to be optimized
-EL_ATTR_WEAK el_err_code_t el_img_convert(const el_img_t* src, el_img_t* dst) {
+EL_ATTR_WEAK void el_img_lut_from_quant(el_img_lut_t* lut, const el_quant_param_t* quant) {
+    EL_ASSERT(lut != nullptr);
+
+    for (int32_t i = 0; i < 256; ++i) {
+        int32_t q = i - 128;
+        if (quant && quant->scale > 0.f) {
+            float v = static_cast<float>(i) / (255.f * quant->scale);
+            q       = static_cast<int32_t>(v + 0.5f) + quant->zero_point;
+        }
+        uint8_t b = static_cast<uint8_t>(static_cast<int8_t>(EL_CLIP(q, -128, 127)));
+
+        lut->table[0][i] = b;
+        lut->table[1][i] = b;
+        lut->table[2][i] = b;
+    }
+}
+
+EL_ATTR_WEAK void el_img_lut_from_norm(el_img_lut_t* lut, const el_img_norm_t* norm, const el_quant_param_t* quant) {
+    EL_ASSERT(lut != nullptr);
+    EL_ASSERT(norm != nullptr);
+
+    if (!quant || quant->scale <= 0.f) {
+        el_img_lut_from_quant(lut, quant);
+        return;
+    }
+
+    for (uint8_t c = 0; c < 3; ++c) {
+        float k = norm->std[c] != 0.f ? 1.f / (255.f * norm->std[c] * quant->scale) : 0.f;
+        float b = norm->std[c] != 0.f ? -norm->mean[c] / (norm->std[c] * quant->scale) : 0.f;
+        for (int32_t i = 0; i < 256; ++i) {
+            // normalized values may be negative, round half away from zero
+            float   v = i * k + b;
+            int32_t q = static_cast<int32_t>(v < 0.f ? v - 0.5f : v + 0.5f) + quant->zero_point;
+
+            lut->table[c][i] = static_cast<uint8_t>(static_cast<int8_t>(EL_CLIP(q, -128, 127)));
+        }
+    }
+}
+
+EL_ATTR_WEAK el_err_code_t el_img_convert(const el_img_t*      src,
+                                          el_img_t*            dst,
+                                          const el_img_lut_t*  lut,
+                                          el_pixel_interp_t    interp,
+                                          const el_img_norm_t* norm) {
     if (!src || !src->data) [[unlikely]]
         return EL_EINVAL;
 
     if (!dst || !dst->data) [[unlikely]]
         return EL_EINVAL;
 
+    // same geometry resampling is nearest, leave it to the direct kernels unless the source has to be decoded, the
+    // destination is planar or normalized, the rotation transposes the image (the plans convert those tile by
+    // tile), the images are strided views or the plan may run in parallel
+    if (dst->format != EL_PIXEL_FORMAT_JPEG &&
+        (src->format == EL_PIXEL_FORMAT_JPEG || dst->format == EL_PIXEL_FORMAT_RGB888_PLANAR || norm ||
+         (interp != EL_PIXEL_INTERP_NEAREST && (src->width != dst->width || src->height != dst->height)) ||
+         dst->rotate == EL_PIXEL_ROTATE_90 || dst->rotate == EL_PIXEL_ROTATE_270 || !is_packed(src) ||
+         !is_packed(dst) ||
+         (CONFIG_EL_CV_THREADS > 1 &&
+          static_cast<uint32_t>(dst->width) * dst->height >= CONFIG_EL_CV_THREADS_MIN_PIXELS))) {
+        ImgConvertPlan plan;
+        auto           ret = plan.build(src, dst, lut, interp, EL_PIXEL_FIT_STRETCH, norm);
+        return ret != EL_OK ? ret : plan.execute(src, dst);
+    }
+
     if (src->format == EL_PIXEL_FORMAT_RGB565 || src->format == EL_PIXEL_FORMAT_RGB888 ||
         src->format == EL_PIXEL_FORMAT_GRAYSCALE) {
 #if CONFIG_EL_LIB_JPEGENC
@@ -995,138 +2261,279 @@ EL_ATTR_WEAK el_err_code_t el_img_convert(const el_img_t* src, el_img_t* dst) {
 
         if (dst->format == EL_PIXEL_FORMAT_RGB565 || dst->format == EL_PIXEL_FORMAT_RGB888 ||
             dst->format == EL_PIXEL_FORMAT_GRAYSCALE) {
-            rgb_to_rgb(src, dst);
+            rgb_to_rgb(src, dst, lut);
             return EL_OK;
         }
     }
 
-    if (src->format == EL_PIXEL_FORMAT_YUV422) {
+    if (is_yuv_format(src->format)) {
         if (dst->format == EL_PIXEL_FORMAT_RGB565 || dst->format == EL_PIXEL_FORMAT_RGB888 ||
             dst->format == EL_PIXEL_FORMAT_GRAYSCALE) {
-            yuv422p_to_rgb(src, dst);
-            return EL_OK;
+            // callers converting every frame should keep their own plan to skip the table setup
+            ImgConvertPlan plan;
+            auto           ret = plan.build(src, dst, lut, interp);
+            return ret != EL_OK ? ret : plan.execute(src, dst);
         }
     }
 
     return EL_ENOTSUP;
 }
 
-// TODO: need to be optimized
-EL_ATTR_WEAK void el_draw_point(el_img_t* img, int16_t x, int16_t y, uint32_t color) {
-    size_t   index = 0;
-    uint8_t* data  = img->data;
+namespace draw {
+
+constexpr uint8_t FONT_FIRST   = 0x20;
+constexpr uint8_t FONT_LAST    = 0x7E;
+constexpr uint8_t FONT_WIDTH   = 5;
+constexpr uint8_t FONT_HEIGHT  = 7;
+constexpr uint8_t FONT_ADVANCE = 6;
+constexpr uint8_t FONT_LINE    = 8;
+
+// printable ascii from FONT_FIRST, one byte per column with the top row in bit 0
+constexpr uint8_t FONT_5X7[FONT_LAST - FONT_FIRST + 1][FONT_WIDTH] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14},
+  {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00},
+  {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+  {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},
+  {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00}, {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31},
+  {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+  {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00}, {0x00, 0x56, 0x36, 0x00, 0x00},
+  {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14}, {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06},
+  {0x32, 0x49, 0x79, 0x41, 0x3E}, {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+  {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x49, 0x49, 0x7A},
+  {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00}, {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41},
+  {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+  {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31},
+  {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F}, {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F},
+  {0x63, 0x14, 0x08, 0x14, 0x63}, {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+  {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},
+  {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78}, {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20},
+  {0x38, 0x44, 0x44, 0x48, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+  {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00},
+  {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78}, {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},
+  {0x7C, 0x14, 0x14, 0x14, 0x08}, {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+  {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C},
+  {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C}, {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},
+  {0x00, 0x00, 0x7F, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08}};
+
+// the drawable rows as stored in memory and the color as stored pixel bytes
+struct canvas_t {
+    uint8_t* data;
+    size_t   pitch;
+    int32_t  width;
+    int32_t  height;
+    uint8_t  bpp;
+    uint8_t  px[3];
+};
+
+static bool make_canvas(el_img_t* img, uint32_t color, canvas_t* c) {
+    if (!img || !img->data) [[unlikely]]
+        return false;
 
     switch (img->format) {
     case EL_PIXEL_FORMAT_GRAYSCALE:
-        index = x + y * img->width;
-        if (index >= img->size) return;
-        data[index] = color;
+        c->px[0] = color;
         break;
-
     case EL_PIXEL_FORMAT_RGB565:
-        index = (x + y * img->width) * 2;
-        if (index >= img->size) return;
-        data[index]     = color & 0xFF;
-        data[index + 1] = (color >> 8) & 0xFF;
+        c->px[0] = (color >> 8) & 0xFF;
+        c->px[1] = color & 0xFF;
         break;
-
     case EL_PIXEL_FORMAT_RGB888:
-        index = (x + y * img->width) * 3;
-        if (index >= img->size) return;
-        data[index]     = color & 0xFF;
-        data[index + 1] = (color >> 8) & 0xFF;
-        data[index + 2] = (color >> 16) & 0xFF;
+        c->px[0] = (color >> 16) & 0xFF;
+        c->px[1] = (color >> 8) & 0xFF;
+        c->px[2] = color & 0xFF;
         break;
-
     default:
-        return;
+        return false;
     }
+
+    bool transposed = img->rotate == EL_PIXEL_ROTATE_90 || img->rotate == EL_PIXEL_ROTATE_270;
+    c->data         = img->data;
+    c->pitch        = el_img_pitch(img);
+    c->width        = stored_width(img);
+    c->height       = transposed ? img->width : img->height;
+    c->bpp          = el_img_bpp(img->format);
+    return true;
 }
 
-EL_ATTR_WEAK void el_fill_rect(el_img_t* img, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t color) {
-    if ((w >> 15) || (h >> 15)) [[unlikely]]
+// the first pixel is written and then copied over in doubling chunks unless all its bytes are the same
+static void fill_span(const canvas_t& c, uint8_t* p, int32_t n) {
+    size_t size = static_cast<size_t>(n) * c.bpp;
+    if (c.bpp == 1 || (c.px[0] == c.px[1] && (c.bpp == 2 || c.px[1] == c.px[2]))) {
+        memset(p, c.px[0], size);
         return;
+    }
 
-    el_pixel_format_t format = img->format;
-    uint16_t          iw     = img->width;
-    uint16_t          ih     = img->height;
+    memcpy(p, c.px, c.bpp);
+    for (size_t done = c.bpp; done < size;) {
+        size_t k = EL_MIN(done, size - done);
+        memcpy(p + done, p, k);
+        done += k;
+    }
+}
 
-    x = x >= iw ? iw : x & ~(x >> 15);
-    y = y >= ih ? ih : y & ~(y >> 15);
-    w = x + w >= iw ? iw - x : w;
-    h = y + h >= ih ? ih - y : h;
+// clipped once, the first row is filled and the others are copies of it
+static void fill_rect(const canvas_t& c, int32_t x, int32_t y, int32_t w, int32_t h) {
+    int32_t x0 = EL_MAX(x, 0);
+    int32_t y0 = EL_MAX(y, 0);
+    int32_t x1 = EL_MIN(x + w, c.width);
+    int32_t y1 = EL_MIN(y + h, c.height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    uint8_t* p    = c.data + y0 * c.pitch + x0 * c.bpp;
+    size_t   size = static_cast<size_t>(x1 - x0) * c.bpp;
+    fill_span(c, p, x1 - x0);
+    for (int32_t r = y0 + 1; r < y1; ++r) memcpy(p + (r - y0) * c.pitch, p, size);
+}
 
-    int32_t  line_step = 0;
-    uint8_t* data      = nullptr;
-    uint8_t  c0        = (color >> 16) & 0xFF;
-    uint8_t  c1        = (color >> 8) & 0xFF;
-    uint8_t  c2        = color;
+// bresenham along the major axis, the pixels sharing a minor coordinate are filled as one run of the brush
+static void draw_line(const canvas_t& c, int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t t) {
+    int32_t lo = (t - 1) >> 1;
+    if (EL_MAX(x0, x1) + t < 0 || EL_MIN(x0, x1) - t >= c.width || EL_MAX(y0, y1) + t < 0 ||
+        EL_MIN(y0, y1) - t >= c.height)
+        return;
 
-    switch (format) {
-    case EL_PIXEL_FORMAT_GRAYSCALE:
-        line_step = iw - w;
-        data      = img->data + x + (y * iw);
+    bool    steep = EL_ABS(y1 - y0) > EL_ABS(x1 - x0);
+    int32_t u     = steep ? y0 : x0;
+    int32_t v     = steep ? x0 : y0;
+    int32_t du    = EL_ABS(steep ? y1 - y0 : x1 - x0);
+    int32_t dv    = EL_ABS(steep ? x1 - x0 : y1 - y0);
+    int32_t su    = (steep ? y1 > y0 : x1 > x0) ? 1 : -1;
+    int32_t sv    = (steep ? x1 > x0 : y1 > y0) ? 1 : -1;
+    int32_t err   = 2 * dv - du;
+    int32_t run   = u;
+
+    for (int32_t i = 0; i <= du; ++i, u += su) {
+        bool step = err > 0;
+        if (step || i == du) {
+            int32_t first = EL_MIN(run, u);
+            int32_t len   = EL_ABS(u - run) + 1;
+            if (steep)
+                fill_rect(c, v - lo, first, t, len);
+            else
+                fill_rect(c, first, v - lo, len, t);
+            run = u + su;
+        }
+        if (step) {
+            v += sv;
+            err -= 2 * du;
+        }
+        err += 2 * dv;
+    }
+}
 
-        for (int i = 0; i < h; ++i, data += line_step) {
-            memset(data, c2, w);
+// midpoint circle, every octant pair gives the half width of two rows
+static void fill_circle(const canvas_t& c, int32_t cx, int32_t cy, int32_t r) {
+    if (cx + r < 0 || cx - r >= c.width || cy + r < 0 || cy - r >= c.height) return;
+
+    int32_t x   = r;
+    int32_t y   = 0;
+    int32_t err = 1 - r;
+    while (x >= y) {
+        fill_rect(c, cx - x, cy + y, 2 * x + 1, 1);
+        if (y) fill_rect(c, cx - x, cy - y, 2 * x + 1, 1);
+        if (err >= 0 && x != y) {
+            fill_rect(c, cx - y, cy + x, 2 * y + 1, 1);
+            fill_rect(c, cx - y, cy - x, 2 * y + 1, 1);
         }
-        break;
 
-    case EL_PIXEL_FORMAT_RGB565:
-        line_step = (iw - w) * 2;
-        data      = img->data + ((x + (y * iw)) * 2);
-        for (int i = 0; i < h; ++i, data += line_step) {
-            for (int j = 0; j < w; ++j, data += 2) {
-                data[0] = c1;
-                data[1] = c2;
-            }
+        ++y;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            --x;
+            err += 2 * (y - x) + 1;
         }
-        break;
+    }
+}
 
-    case EL_PIXEL_FORMAT_RGB888:
-        line_step = (iw - w) * 3;
-        data      = img->data + ((x + (y * iw)) * 3);
-        for (int i = 0; i < h; ++i, data += line_step) {
-            for (int j = 0; j < w; ++j, data += 3) {
-                data[0] = c0;
-                data[1] = c1;
-                data[2] = c2;
+// each glyph row is split in runs of set columns, a run is one scale x scale (or wider) rectangle
+static void draw_text(const canvas_t& c, int32_t x, int32_t y, const char* text, int32_t scale) {
+    int32_t left = x;
+    for (; *text; ++text) {
+        uint8_t ch = static_cast<uint8_t>(*text);
+        if (ch == '\n') {
+            x = left;
+            y += FONT_LINE * scale;
+            continue;
+        }
+        if (y >= c.height) return;
+
+        if (x < c.width && x + FONT_WIDTH * scale > 0 && y + FONT_HEIGHT * scale > 0) {
+            const uint8_t* glyph = FONT_5X7[(ch < FONT_FIRST || ch > FONT_LAST ? '?' : ch) - FONT_FIRST];
+            for (uint8_t row = 0; row < FONT_HEIGHT; ++row) {
+                for (uint8_t col = 0; col < FONT_WIDTH;) {
+                    if (!((glyph[col] >> row) & 1)) {
+                        ++col;
+                        continue;
+                    }
+                    uint8_t first = col;
+                    while (col < FONT_WIDTH && ((glyph[col] >> row) & 1)) ++col;
+                    fill_rect(c, x + first * scale, y + row * scale, (col - first) * scale, scale);
+                }
             }
         }
-        break;
+        x += FONT_ADVANCE * scale;
+    }
+}
 
-    default:
+}  // namespace draw
+
+EL_ATTR_WEAK void el_draw_point(el_img_t* img, int16_t x, int16_t y, uint32_t color) {
+    draw::canvas_t c;
+    if (!draw::make_canvas(img, color, &c)) [[unlikely]]
         return;
-    }
+    draw::fill_rect(c, x, y, 1, 1);
+}
+
+EL_ATTR_WEAK void el_fill_rect(el_img_t* img, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t color) {
+    draw::canvas_t c;
+    if (!draw::make_canvas(img, color, &c)) [[unlikely]]
+        return;
+    draw::fill_rect(c, x, y, w, h);
 }
 
-// TODO: need to be optimized
 EL_ATTR_WEAK void el_draw_h_line(el_img_t* img, int16_t x0, int16_t x1, int16_t y, uint32_t color) {
     el_fill_rect(img, x0, y, x1 - x0, 1, color);
 }
 
-// TODO: need to be optimized
 EL_ATTR_WEAK void el_draw_v_line(el_img_t* img, int16_t x, int16_t y0, int16_t y1, uint32_t color) {
     el_fill_rect(img, x, y0, 1, y1 - y0, color);
 }
 
-// TODO: need to be optimized
+// the outline covers (w + 1) x (h + 1) pixels and grows inwards with the thickness, drawn as 4 bands
 EL_ATTR_WEAK void el_draw_rect(
   el_img_t* img, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t color, uint8_t thickness) {
-    int16_t x_add_i = 0;
-    int16_t x_sub_i = 0;
-    int16_t y_add_i = 0;
-    int16_t y_sub_i = 0;
-    for (uint8_t i = 0; i < thickness; ++i) {
-        x_add_i = x + i;
-        x_sub_i = x - i;
-        y_add_i = y + i;
-        y_sub_i = y - i;
-        el_draw_h_line(img, x_add_i, (x_sub_i + w), y_add_i, color);
-        el_draw_h_line(img, x_add_i, (x_sub_i + w) + 1, (y_sub_i + h), color);
-        el_draw_v_line(img, x_add_i, y_add_i, (y_sub_i + h), color);
-        el_draw_v_line(img, (x_sub_i + w), y_add_i, (y_sub_i + h) + 1, color);
-    }
+    draw::canvas_t c;
+    if (!draw::make_canvas(img, color, &c) || !thickness || w < 0 || h < 0) [[unlikely]]
+        return;
+
+    int32_t t = thickness;
+    draw::fill_rect(c, x, y, w + 1, t);
+    draw::fill_rect(c, x, y + h + 1 - t, w + 1, t);
+    draw::fill_rect(c, x, y + t, t, h + 1 - 2 * t);
+    draw::fill_rect(c, x + w + 1 - t, y + t, t, h + 1 - 2 * t);
+}
+
+EL_ATTR_WEAK void el_draw_line(
+  el_img_t* img, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint32_t color, uint8_t thickness) {
+    draw::canvas_t c;
+    if (!draw::make_canvas(img, color, &c) || !thickness) [[unlikely]]
+        return;
+    draw::draw_line(c, x0, y0, x1, y1, thickness);
+}
+
+EL_ATTR_WEAK void el_fill_circle(el_img_t* img, int16_t x, int16_t y, uint16_t r, uint32_t color) {
+    draw::canvas_t c;
+    if (!draw::make_canvas(img, color, &c)) [[unlikely]]
+        return;
+    draw::fill_circle(c, x, y, r);
+}
+
+EL_ATTR_WEAK void el_draw_text(el_img_t* img, int16_t x, int16_t y, const char* text, uint32_t color, uint8_t scale) {
+    draw::canvas_t c;
+    if (!text || !scale || !draw::make_canvas(img, color, &c)) [[unlikely]]
+        return;
+    draw::draw_text(c, x, y, text, scale);
 }
 
 }  // namespace edgelab
@@ -32,8 +32,207 @@
 
 namespace edgelab {
 
-el_err_code_t el_img_convert(const el_img_t* src, el_img_t* dst);
+namespace types {
 
+// per-channel byte mapping applied by the converters while storing RGB888 / grayscale pixels,
+// table[0] is also used for grayscale destinations
+typedef struct el_img_lut_t {
+    uint8_t table[3][256];
+} el_img_lut_t;
+
+// maps destination coordinates of a fitted conversion back to the source, the source covers the w x h area at
+// (x_offset, y_offset) of the destination and x_src = (x_dst - x_offset) * x_scale
+typedef struct el_img_map_t {
+    float    x_scale;
+    float    y_scale;
+    uint16_t x_offset;
+    uint16_t y_offset;
+    uint16_t w;
+    uint16_t h;
+} el_img_map_t;
+
+// per-channel affine normalization (x / 255 - mean) / std of the stored channels, gray uses the first channel
+typedef struct el_img_norm_t {
+    float mean[3];
+    float std[3];
+} el_img_norm_t;
+
+typedef enum el_jpeg_quality_t {
+    EL_JPEG_QUALITY_BEST = 0,
+    EL_JPEG_QUALITY_HIGH,
+    EL_JPEG_QUALITY_MEDIUM,
+    EL_JPEG_QUALITY_LOW,
+} el_jpeg_quality_t;
+
+typedef enum el_jpeg_subsample_t {
+    EL_JPEG_SUBSAMPLE_444 = 0,
+    EL_JPEG_SUBSAMPLE_420,
+} el_jpeg_subsample_t;
+
+typedef struct el_jpeg_config_t {
+    el_jpeg_quality_t   quality;
+    el_jpeg_subsample_t subsample;
+} el_jpeg_config_t;
+
+// receives the compressed bytes in order as the encoder produces them, anything but EL_OK aborts the encoding
+typedef el_err_code_t (*el_jpeg_sink_t)(const uint8_t* data, size_t size, void* user);
+
+struct resize_coeff_t;
+
+}  // namespace types
+
+using namespace edgelab::types;
+
+// bytes per pixel of the packed formats, 0 for the planar, semi-planar and compressed ones
+uint8_t el_img_bpp(el_pixel_format_t format);
+
+// bytes per row as stored in memory, rotated images store height rows of width pixels when rotated by 90 or 270
+size_t el_img_pitch(const el_img_t* img);
+
+// describes the w x h sub-rectangle at (x, y) of a packed image in memory coordinates without copying it, the view
+// shares the pitch of the image and may be passed to any converter or drawing primitive
+el_err_code_t el_img_view(const el_img_t* img, uint16_t x, uint16_t y, uint16_t w, uint16_t h, el_img_t* view);
+
+// stretch covers the whole destination, letterbox scales uniformly and centers the source in the destination
+void el_img_fit_map(const el_img_t* src, const el_img_t* dst, el_pixel_fit_t fit, el_img_map_t* map);
+
+// builds a lut that maps [0, 255] pixels to the int8 input domain described by quant (x / 255 / scale + zero_point),
+// falls back to the plain (x - 128) shift if the tensor is not quantized
+void el_img_lut_from_quant(el_img_lut_t* lut, const el_quant_param_t* quant);
+
+// builds a lut that normalizes every channel with norm and quantizes the result to the int8 input domain described by
+// quant, falls back to el_img_lut_from_quant if the tensor is not quantized
+void el_img_lut_from_norm(el_img_lut_t* lut, const el_img_norm_t* norm, const el_quant_param_t* quant);
+
+// bilinear and area (box) are computed in fixed point, area falls back to nearest when upscaling, baseline jpeg
+// sources are decoded at the smallest 1/2, 1/4 or 1/8 scale that still covers the destination, RGB888, planar RGB888
+// and grayscale destinations hold float32 channels normalized after the lut if norm is given
+el_err_code_t el_img_convert(const el_img_t*      src,
+                             el_img_t*            dst,
+                             const el_img_lut_t*  lut    = nullptr,
+                             el_pixel_interp_t    interp = EL_PIXEL_INTERP_NEAREST,
+                             const el_img_norm_t* norm   = nullptr);
+
+// bytes needed by a pyramid whose first level is base (size and format), every next level is the previous one
+// divided by ratio and rounded down, the levels are packed one after the other at 4 bytes aligned offsets
+size_t el_img_pyramid_size(const el_img_t* base, uint8_t count, float ratio = 2.f);
+
+// levels[0] gives the size, format and rotation of the first level which is converted from src with interp, every
+// next level is box filtered from the previous one, levels receives count images laid out in buf
+el_err_code_t el_img_pyramid(const el_img_t*   src,
+                             el_img_t*         levels,
+                             uint8_t           count,
+                             uint8_t*          buf,
+                             size_t            size,
+                             float             ratio  = 2.f,
+                             el_pixel_interp_t interp = EL_PIXEL_INTERP_NEAREST);
+
+// a conversion plan is built once for a (src geometry, dst geometry, formats, rotation, interp, lut) and then
+// executed on every frame, the sampling tables and rotated strides are never recomputed per pixel
+class ImgConvertPlan {
+   public:
+    ImgConvertPlan();
+    ~ImgConvertPlan();
+
+    ImgConvertPlan(const ImgConvertPlan&)            = delete;
+    ImgConvertPlan& operator=(const ImgConvertPlan&) = delete;
+
+    // lut is referenced (not copied) by the plan and must outlive it, a letterbox pad is written around the converted
+    // area on every execution, jpeg
+    // sources are read for their frame header and decoded on each execution at the smallest idct scale that still
+    // covers the destination, with norm the channels are stored as float32 (the pitch of dst is then counted in
+    // bytes of floats) and planar destinations store each plane right after the previous one
+    el_err_code_t build(const el_img_t*      src,
+                        const el_img_t*      dst,
+                        const el_img_lut_t*  lut    = nullptr,
+                        el_pixel_interp_t    interp = EL_PIXEL_INTERP_NEAREST,
+                        el_pixel_fit_t       fit    = EL_PIXEL_FIT_STRETCH,
+                        const el_img_norm_t* norm   = nullptr);
+    void          release();
+
+    bool          is_built_for(const el_img_t* src, const el_img_t* dst) const;
+    el_err_code_t execute(const el_img_t* src, el_img_t* dst);
+
+   private:
+    using RowFn  = void (*)(const ImgConvertPlan* plan,
+                           const uint8_t* const* src_rows,
+                           uint8_t*              dst,
+                           int32_t               idx,
+                           uint16_t              begin,
+                           uint16_t              end);
+    using SpanFn = void (*)(const uint8_t* src, uint8_t* dst, size_t n);
+
+    template <el_pixel_format_t S, el_pixel_format_t D, bool F>
+    static void nearest_row(const ImgConvertPlan* plan,
+                            const uint8_t* const* src_rows,
+                            uint8_t*              dst,
+                            int32_t               idx,
+                            uint16_t              begin,
+                            uint16_t              end);
+
+    static RowFn select_nearest_row(el_pixel_format_t src_format, el_pixel_format_t dst_format, bool normalized);
+
+    el_err_code_t build_jpeg(const el_img_t* src, const el_img_t* dst, el_pixel_fit_t fit, el_img_t* decoded);
+
+    uint16_t slice_row(uint8_t slice) const;
+    void     execute_nearest(const el_img_t* src, el_img_t* dst, uint16_t first, uint16_t last) const;
+    void     execute_resample(const el_img_t* src, el_img_t* dst, uint8_t slice, uint16_t first, uint16_t last) const;
+    void     store_lines(uint8_t* dst, const uint8_t* line, uint16_t first, uint16_t count) const;
+    void     fill_pad(uint8_t* dst) const;
+
+    bool              _built;
+    el_img_t          _src;
+    el_img_t          _dst;     // converted area, the whole canvas unless letterboxed
+    el_img_t          _canvas;  // destination as passed to build
+    el_pixel_interp_t _interp;
+    uint8_t           _ch;
+
+    uint8_t _elem;      // destination bytes per pixel of a row (of a plane if planar)
+    size_t  _plane;     // destination byte offset between channels, a whole plane if planar
+    float*  _norm;      // [3][256] normalized float channels after the lut, nullptr for byte destinations
+
+    int32_t _row_base;  // destination byte offset of (0, 0)
+    int32_t _row_step;  // destination byte offset step to the next row
+    int32_t _col_step;  // destination byte offset step to the next column
+    bool    _tiled;     // 90 and 270 degrees rotations write columns and are processed in square tiles
+    uint8_t _slices;    // destination row slices converted in parallel, 1 on the calling thread only
+
+    el_img_t _jpeg;        // jpeg source as passed to build, _src is then the decoded intermediate
+    uint8_t  _jpeg_scale;  // idct downscale of the jpeg source, 0 if the source is not compressed
+    uint8_t* _jpeg_buf;
+
+    el_pixel_fit_t _fit;
+    uint16_t       _area_x;  // converted area of the canvas in memory coordinates
+    uint16_t       _area_y;
+    uint16_t       _area_w;
+    uint16_t       _area_h;
+
+    const uint8_t* _lut[3];
+    uint8_t        _lut_r5[32];
+    uint8_t        _lut_g6[64];
+    uint8_t        _lut_b5[32];
+
+    RowFn  _row_fn;
+    SpanFn _span_fn;  // whole image in one contiguous span, set when there is nothing to resample, rotate or map
+
+    uint8_t*        _pool;
+    uint32_t*       _xofs;  // nearest: byte offset of the source pixel in a row
+    uint32_t*       _yofs;  // nearest: byte offset of the source row
+    resize_coeff_t* _xtab;
+    resize_coeff_t* _ytab;
+    uint8_t*        _rows;
+    uint8_t*        _line;
+    uint8_t*        _buf;
+};
+
+// encodes a grayscale, RGB565 or RGB888 image (4:4:4 at low quality if config is null, grayscale is never
+// subsampled), the compressed bytes are streamed to sink in chunks of at most 2 KiB and size receives the total
+// encoded size if not null
+el_err_code_t el_img_encode_jpeg(
+  const el_img_t* src, const el_jpeg_config_t* config, el_jpeg_sink_t sink, void* user, size_t* size = nullptr);
+
+// color is the pixel value in the format of img (0xRRGGBB, an RGB565 value or a gray level), coordinates are those of
+// the rows as stored in memory and every primitive is clipped once before being filled span by span
 void el_draw_rect(el_img_t* img, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t color, uint8_t thickness = 1);
 
 void el_fill_rect(el_img_t* img, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t color);
@@ -44,6 +243,14 @@ void el_draw_h_line(el_img_t* img, int16_t x0, int16_t x1, int16_t y, uint32_t c
 
 void el_draw_v_line(el_img_t* img, int16_t x, int16_t y0, int16_t y1, uint32_t color);
 
+void el_draw_line(
+  el_img_t* img, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint32_t color, uint8_t thickness = 1);
+
+void el_fill_circle(el_img_t* img, int16_t x, int16_t y, uint16_t r, uint32_t color);
+
+// 5 x 7 glyphs on a 6 x 8 grid times scale, '\n' starts a new line and characters outside printable ascii show as '?'
+void el_draw_text(el_img_t* img, int16_t x, int16_t y, const char* text, uint32_t color, uint8_t scale = 1);
+
 }  // namespace edgelab
 
 #endif
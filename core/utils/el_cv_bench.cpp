@@ -0,0 +1,373 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_cv_bench.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "core/el_common.h"
+#include "core/el_debug.h"
+#include "core/el_types.h"
+#include "el_cv.h"
+
+namespace edgelab {
+
+namespace bench {
+
+constexpr float DEFAULT_RATIOS[] = {1.f, 1.f / 2.f, 3.f / 10.f};
+
+constexpr uint32_t SRC_FORMATS = (1u << EL_PIXEL_FORMAT_RGB888) | (1u << EL_PIXEL_FORMAT_RGB565) |
+                                 (1u << EL_PIXEL_FORMAT_YUV422) | (1u << EL_PIXEL_FORMAT_GRAYSCALE) |
+                                 (1u << EL_PIXEL_FORMAT_JPEG) | (1u << EL_PIXEL_FORMAT_YUYV) |
+                                 (1u << EL_PIXEL_FORMAT_UYVY) | (1u << EL_PIXEL_FORMAT_NV12) |
+                                 (1u << EL_PIXEL_FORMAT_NV21);
+
+constexpr uint32_t DST_FORMATS = (1u << EL_PIXEL_FORMAT_RGB888) | (1u << EL_PIXEL_FORMAT_RGB565) |
+                                 (1u << EL_PIXEL_FORMAT_GRAYSCALE) | (1u << EL_PIXEL_FORMAT_RGB888_PLANAR);
+
+constexpr const char* FORMAT_NAMES[] = {
+  "RGB888", "RGB565", "YUV422", "GRAYSCALE", "JPEG", "YUYV", "UYVY", "NV12", "NV21", "RGB888_PLANAR"};
+
+constexpr const char* INTERP_NAMES[]    = {"nearest", "bilinear", "area"};
+constexpr const char* QUALITY_NAMES[]   = {"best", "high", "medium", "low"};
+constexpr const char* SUBSAMPLE_NAMES[] = {"444", "420"};
+
+static const char* format_name(el_pixel_format_t format) {
+    return format < sizeof(FORMAT_NAMES) / sizeof(FORMAT_NAMES[0]) ? FORMAT_NAMES[format] : "UNKNOWN";
+}
+
+// bytes of a packed width x height frame, the jpeg source is sized for its worst case
+static size_t frame_size(el_pixel_format_t format, uint16_t width, uint16_t height) {
+    size_t area = static_cast<size_t>(width) * height;
+    switch (format) {
+    case EL_PIXEL_FORMAT_NV12:
+    case EL_PIXEL_FORMAT_NV21:
+        return area + (area >> 1);
+    case EL_PIXEL_FORMAT_YUV422:
+    case EL_PIXEL_FORMAT_RGB888_PLANAR:
+        return area * (format == EL_PIXEL_FORMAT_YUV422 ? 2 : 3);
+    case EL_PIXEL_FORMAT_JPEG:
+        return area * 3;
+    default:
+        return area * el_img_bpp(format);
+    }
+}
+
+struct buffer_t {
+    uint8_t* data;
+    size_t   capacity;
+    size_t   size;
+};
+
+static el_err_code_t buffer_write(const uint8_t* data, size_t size, void* user) {
+    auto* buf = static_cast<buffer_t*>(user);
+    if (buf->size + size > buf->capacity) [[unlikely]]
+        return EL_ENOMEM;
+    memcpy(buf->data + buf->size, data, size);
+    buf->size += size;
+    return EL_OK;
+}
+
+static el_err_code_t count_write(const uint8_t*, size_t size, void* user) {
+    *static_cast<size_t*>(user) += size;
+    return EL_OK;
+}
+
+// gradients with some texture so the encoder and the decoder see a realistic amount of detail
+static void fill_rgb888(uint8_t* p, uint16_t width, uint16_t height) {
+    for (uint16_t y = 0; y < height; ++y)
+        for (uint16_t x = 0; x < width; ++x, p += 3) {
+            p[0] = static_cast<uint8_t>(x * 255 / EL_MAX(width - 1, 1));
+            p[1] = static_cast<uint8_t>(y * 255 / EL_MAX(height - 1, 1));
+            p[2] = static_cast<uint8_t>(((x ^ y) & 0x3F) << 2);
+        }
+}
+
+// the source frame in format, converted from base when el_cv can produce the format
+static el_err_code_t make_source(const el_img_t* base, el_pixel_format_t format, el_img_t* src) {
+    *src        = *base;
+    src->format = format;
+    src->size   = frame_size(format, base->width, base->height);
+    src->data   = static_cast<uint8_t*>(el_malloc(src->size));
+    if (!src->data) [[unlikely]]
+        return EL_ENOMEM;
+
+    switch (format) {
+    case EL_PIXEL_FORMAT_RGB888:
+    case EL_PIXEL_FORMAT_RGB565:
+    case EL_PIXEL_FORMAT_GRAYSCALE:
+        return el_img_convert(base, src);
+
+    case EL_PIXEL_FORMAT_JPEG: {
+        el_jpeg_config_t config{.quality = EL_JPEG_QUALITY_HIGH, .subsample = EL_JPEG_SUBSAMPLE_420};
+        buffer_t         buf{.data = src->data, .capacity = src->size, .size = 0};
+        auto             ret = el_img_encode_jpeg(base, &config, buffer_write, &buf);
+        src->size            = buf.size;
+        return ret;
+    }
+
+    default:
+        // yuv layouts are read sample by sample whatever their content, a hashed pattern is enough
+        for (size_t i = 0; i < src->size; ++i) src->data[i] = static_cast<uint8_t>((i * 2654435761u) >> 24);
+        return EL_OK;
+    }
+}
+
+// runs once to check the case and warm the caches, then repeats it for at least min_time_ms
+template <typename F> static void measure(el_cv_bench_result_t* result, uint32_t min_time_ms, F&& run) {
+    result->iterations = 0;
+    result->time_us    = 0;
+    result->kpix_per_s = 0;
+    result->status     = run();
+    if (result->status != EL_OK) return;
+
+    uint64_t start = el_get_time_us();
+    uint64_t now   = start;
+    do {
+        run();
+        ++result->iterations;
+        now = el_get_time_us();
+    } while (now - start < static_cast<uint64_t>(min_time_ms) * 1000u);
+
+    uint64_t pixels    = static_cast<uint64_t>(result->src_width) * result->src_height * result->iterations;
+    result->time_us    = now - start;
+    result->kpix_per_s = result->time_us ? static_cast<uint32_t>(pixels * 1000u / result->time_us) : 0;
+}
+
+static el_err_code_t print_result(const el_cv_bench_result_t* result, void*) {
+    char line[384];
+    el_cv_bench_to_json(result, line, sizeof(line));
+    el_printf("%s\n", line);
+    return EL_OK;
+}
+
+}  // namespace bench
+
+int el_cv_bench_to_json(const el_cv_bench_result_t* result, char* buf, size_t size) {
+    EL_ASSERT(result != nullptr);
+
+    // the fields that only make sense for the conversions or for the encoder
+    char extra[96];
+    if (result->dst_format == EL_PIXEL_FORMAT_JPEG)
+        snprintf(extra,
+                 sizeof(extra),
+                 "\"quality\":\"%s\",\"subsample\":\"%s\",\"out_size\":%u,",
+                 bench::QUALITY_NAMES[result->quality & 3],
+                 bench::SUBSAMPLE_NAMES[result->subsample & 1],
+                 static_cast<unsigned>(result->out_size));
+    else
+        snprintf(extra,
+                 sizeof(extra),
+                 "\"rotate\":%u,\"interp\":\"%s\",",
+                 static_cast<unsigned>(result->rotate) * 90u,
+                 result->interp < EL_PIXEL_INTERP_UNKNOWN ? bench::INTERP_NAMES[result->interp] : "unknown");
+
+    // megapixels per second with 2 decimals, printf builds without float support are common on the targets
+    return snprintf(buf,
+                    size,
+                    "{\"kernel\":\"%s\",\"src\":\"%s\",\"dst\":\"%s\",\"src_size\":[%u,%u],\"dst_size\":[%u,%u],%s"
+                    "\"status\":%d,\"iterations\":%" PRIu32 ",\"time_us\":%" PRIu64 ",\"mpix_s\":%" PRIu32
+                    ".%02" PRIu32 "}",
+                    result->kernel,
+                    bench::format_name(result->src_format),
+                    bench::format_name(result->dst_format),
+                    result->src_width,
+                    result->src_height,
+                    result->dst_width,
+                    result->dst_height,
+                    extra,
+                    static_cast<int>(result->status),
+                    result->iterations,
+                    result->time_us,
+                    result->kpix_per_s / 1000u,
+                    result->kpix_per_s % 1000u / 10u);
+}
+
+EL_ATTR_WEAK el_err_code_t el_cv_bench(const el_cv_bench_config_t* config, el_cv_bench_sink_t sink, void* user) {
+    el_cv_bench_config_t cfg{};
+    if (config) cfg = *config;
+    if (!cfg.width || !cfg.height) {
+        cfg.width  = 640;
+        cfg.height = 480;
+    }
+    if (!cfg.src_formats) cfg.src_formats = bench::SRC_FORMATS;
+    if (!cfg.dst_formats) cfg.dst_formats = bench::DST_FORMATS;
+    if (!cfg.rotates) cfg.rotates = (1u << EL_PIXEL_ROTATE_UNKNOWN) - 1;
+    if (!cfg.interps) cfg.interps = (1u << EL_PIXEL_INTERP_UNKNOWN) - 1;
+    if (!cfg.ratios || !cfg.ratio_count) {
+        cfg.ratios      = bench::DEFAULT_RATIOS;
+        cfg.ratio_count = sizeof(bench::DEFAULT_RATIOS) / sizeof(bench::DEFAULT_RATIOS[0]);
+    }
+    if (!cfg.min_time_ms) cfg.min_time_ms = 50;
+    if (!sink) sink = bench::print_result;
+
+    // the interleaved yuv layouts pair their pixels
+    if (cfg.width & 1) [[unlikely]]
+        return EL_EINVAL;
+
+    // one destination buffer serves every case, sized for the largest ratio
+    float max_ratio = 0.f;
+    for (uint8_t k = 0; k < cfg.ratio_count; ++k) {
+        if (cfg.ratios[k] <= 0.f) [[unlikely]]
+            return EL_EINVAL;
+        max_ratio = EL_MAX(max_ratio, cfg.ratios[k]);
+    }
+    auto side = [](uint16_t s, float ratio) {
+        return static_cast<uint16_t>(EL_CLIP(static_cast<int32_t>(s * ratio + 0.5f), 1, UINT16_MAX));
+    };
+
+    el_img_t base{};
+    base.width  = cfg.width;
+    base.height = cfg.height;
+    base.format = EL_PIXEL_FORMAT_RGB888;
+    base.rotate = EL_PIXEL_ROTATE_0;
+    base.size   = bench::frame_size(EL_PIXEL_FORMAT_RGB888, cfg.width, cfg.height);
+
+    size_t dst_size =
+      bench::frame_size(EL_PIXEL_FORMAT_RGB888_PLANAR, side(cfg.width, max_ratio), side(cfg.height, max_ratio));
+
+    base.data     = static_cast<uint8_t*>(el_malloc(base.size));
+    auto* dst_buf = static_cast<uint8_t*>(el_malloc(dst_size));
+    if (!base.data || !dst_buf) [[unlikely]] {
+        if (base.data) el_free(base.data);
+        if (dst_buf) el_free(dst_buf);
+        return EL_ENOMEM;
+    }
+    bench::fill_rgb888(base.data, base.width, base.height);
+
+    el_err_code_t ret = EL_OK;
+
+    for (uint8_t sf = 0; sf < EL_PIXEL_FORMAT_UNKNOWN && ret == EL_OK; ++sf) {
+        if (!(cfg.src_formats & (1u << sf))) continue;
+
+        el_img_t src;
+        auto     made = bench::make_source(&base, static_cast<el_pixel_format_t>(sf), &src);
+
+        for (uint8_t df = 0; df < EL_PIXEL_FORMAT_UNKNOWN && ret == EL_OK; ++df) {
+            if (!(cfg.dst_formats & (1u << df)) || df == EL_PIXEL_FORMAT_JPEG) continue;
+
+            for (uint8_t k = 0; k < cfg.ratio_count && ret == EL_OK; ++k) {
+                for (uint8_t rot = 0; rot < EL_PIXEL_ROTATE_UNKNOWN && ret == EL_OK; ++rot) {
+                    if (!(cfg.rotates & (1u << rot))) continue;
+
+                    for (uint8_t in = 0; in < EL_PIXEL_INTERP_UNKNOWN && ret == EL_OK; ++in) {
+                        if (!(cfg.interps & (1u << in))) continue;
+
+                        el_img_t dst{};
+                        dst.data   = dst_buf;
+                        dst.width  = side(cfg.width, cfg.ratios[k]);
+                        dst.height = side(cfg.height, cfg.ratios[k]);
+                        dst.format = static_cast<el_pixel_format_t>(df);
+                        dst.rotate = static_cast<el_pixel_rotate_t>(rot);
+                        dst.size   = bench::frame_size(dst.format, dst.width, dst.height);
+
+                        el_cv_bench_result_t result{};
+                        result.src_format = src.format;
+                        result.dst_format = dst.format;
+                        result.rotate     = dst.rotate;
+                        result.interp     = static_cast<el_pixel_interp_t>(in);
+                        result.src_width  = src.width;
+                        result.src_height = src.height;
+                        result.dst_width  = dst.width;
+                        result.dst_height = dst.height;
+
+                        // one shot conversions, building a plan when el_img_convert needs one
+                        result.kernel = "convert";
+                        if (made == EL_OK)
+                            bench::measure(&result, cfg.min_time_ms, [&]() {
+                                return el_img_convert(&src, &dst, nullptr, result.interp);
+                            });
+                        else
+                            result.status = made;
+                        ret = sink(&result, user);
+                        if (ret != EL_OK) break;
+
+                        // the steady state of the algorithms, a plan built once and executed on every frame
+                        ImgConvertPlan plan;
+                        result.kernel     = "plan";
+                        result.iterations = 0;
+                        result.time_us    = 0;
+                        result.kpix_per_s = 0;
+                        result.status     = made == EL_OK ? plan.build(&src, &dst, nullptr, result.interp) : made;
+                        if (result.status == EL_OK)
+                            bench::measure(&result, cfg.min_time_ms, [&]() { return plan.execute(&src, &dst); });
+                        ret = sink(&result, user);
+                    }
+                }
+            }
+        }
+
+        if (src.data) el_free(src.data);
+    }
+
+    // the encoder takes the packed formats it can read, at every quality and subsampling
+    for (uint8_t sf = 0; sf < EL_PIXEL_FORMAT_UNKNOWN && ret == EL_OK; ++sf) {
+        if (!(cfg.src_formats & (1u << sf)) ||
+            (sf != EL_PIXEL_FORMAT_RGB888 && sf != EL_PIXEL_FORMAT_RGB565 && sf != EL_PIXEL_FORMAT_GRAYSCALE))
+            continue;
+
+        el_img_t src;
+        auto     made = bench::make_source(&base, static_cast<el_pixel_format_t>(sf), &src);
+
+        for (uint8_t q = EL_JPEG_QUALITY_BEST; q <= EL_JPEG_QUALITY_LOW && ret == EL_OK; ++q) {
+            for (uint8_t ss = EL_JPEG_SUBSAMPLE_444; ss <= EL_JPEG_SUBSAMPLE_420 && ret == EL_OK; ++ss) {
+                el_jpeg_config_t jpeg{.quality   = static_cast<el_jpeg_quality_t>(q),
+                                      .subsample = static_cast<el_jpeg_subsample_t>(ss)};
+
+                el_cv_bench_result_t result{};
+                result.kernel     = "encode_jpeg";
+                result.src_format = src.format;
+                result.dst_format = EL_PIXEL_FORMAT_JPEG;
+                result.rotate     = EL_PIXEL_ROTATE_0;
+                result.quality    = jpeg.quality;
+                result.subsample  = jpeg.subsample;
+                result.src_width  = src.width;
+                result.src_height = src.height;
+                result.dst_width  = src.width;
+                result.dst_height = src.height;
+
+                if (made == EL_OK)
+                    bench::measure(&result, cfg.min_time_ms, [&]() {
+                        result.out_size = 0;
+                        return el_img_encode_jpeg(&src, &jpeg, bench::count_write, &result.out_size);
+                    });
+                else
+                    result.status = made;
+                ret = sink(&result, user);
+            }
+        }
+
+        if (src.data) el_free(src.data);
+    }
+
+    el_free(dst_buf);
+    el_free(base.data);
+
+    return ret;
+}
+
+}  // namespace edgelab
@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_CV_BENCH_H_
+#define _EL_CV_BENCH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/el_types.h"
+#include "el_cv.h"
+
+namespace edgelab {
+
+namespace types {
+
+typedef struct el_cv_bench_config_t {
+    uint16_t     width;        // source size
+    uint16_t     height;
+    uint32_t     src_formats;  // masks of 1u << el_pixel_format_t, 0 selects every supported format
+    uint32_t     dst_formats;
+    uint8_t      rotates;      // mask of 1u << el_pixel_rotate_t, 0 selects every rotation
+    uint8_t      interps;      // mask of 1u << el_pixel_interp_t, 0 selects every interpolation
+    const float* ratios;       // destination to source sizes, {1, 1/2, 3/10} if null
+    uint8_t      ratio_count;
+    uint32_t     min_time_ms;  // each case is repeated for at least this long, and at least once
+} el_cv_bench_config_t;
+
+typedef struct el_cv_bench_result_t {
+    const char*         kernel;      // "convert" (el_img_convert), "plan" (built once, executed) or "encode_jpeg"
+    el_pixel_format_t   src_format;
+    el_pixel_format_t   dst_format;  // EL_PIXEL_FORMAT_JPEG for the encoder
+    el_pixel_rotate_t   rotate;
+    el_pixel_interp_t   interp;
+    el_jpeg_quality_t   quality;     // encoder only
+    el_jpeg_subsample_t subsample;   // encoder only
+    uint16_t            src_width;
+    uint16_t            src_height;
+    uint16_t            dst_width;
+    uint16_t            dst_height;
+    el_err_code_t       status;      // cases failing on their first run report the error and no timing
+    uint32_t            iterations;
+    uint64_t            time_us;     // all iterations
+    uint32_t            kpix_per_s;  // source pixels
+    size_t              out_size;    // encoded bytes, 0 for conversions
+} el_cv_bench_result_t;
+
+// receives every result as soon as its case is measured, anything but EL_OK stops the benchmark
+typedef el_err_code_t (*el_cv_bench_sink_t)(const el_cv_bench_result_t* result, void* user);
+
+}  // namespace types
+
+using namespace edgelab::types;
+
+// measures the pixel throughput of every (source format, destination format, rotation, interpolation, size ratio)
+// conversion and of the jpeg encoder at every quality and subsampling on a synthetic frame, results are printed as
+// json lines if sink is null, the defaults (640 x 480, every case, 50 ms each) are used if config is null
+el_err_code_t el_cv_bench(const el_cv_bench_config_t* config, el_cv_bench_sink_t sink = nullptr, void* user = nullptr);
+
+// formats a result as a single line json object, returns the length snprintf would have written
+int el_cv_bench_to_json(const el_cv_bench_result_t* result, char* buf, size_t size);
+
+}  // namespace edgelab
+
+#endif
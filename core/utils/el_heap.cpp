@@ -0,0 +1,147 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_heap.h"
+
+#include <atomic>
+
+#include "core/el_config_internal.h"
+#include "core/synchronize/el_guard.hpp"
+#include "core/synchronize/el_mutex.hpp"
+
+namespace edgelab {
+
+namespace {
+
+// blocks are laid out back to back in each region, free neighbours are merged whenever a walk passes them
+struct alignas(16) block_t {
+    size_t size;  // header included
+    bool   used;
+};
+
+struct region_t {
+    uint8_t* begin;
+    uint8_t* end;
+};
+
+Mutex               heap_lock;
+region_t            heap_regions[CONFIG_EL_HEAP_REGIONS_MAX];
+std::atomic<size_t> heap_region_count{0};
+
+inline size_t align_up(size_t n) { return (n + alignof(block_t) - 1) & ~(alignof(block_t) - 1); }
+
+inline block_t* next_of(block_t* block) {
+    return reinterpret_cast<block_t*>(reinterpret_cast<uint8_t*>(block) + block->size);
+}
+
+inline void merge_free(block_t* block, block_t* end) {
+    for (auto* next = next_of(block); next < end && !next->used; next = next_of(block)) block->size += next->size;
+}
+
+}  // namespace
+
+el_err_code_t el_heap_lend(void* ptr, size_t size) {
+    if (ptr == nullptr) [[unlikely]]
+        return EL_EINVAL;
+
+    auto begin = align_up(reinterpret_cast<uintptr_t>(ptr));
+    auto end   = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(alignof(block_t) - 1);
+    if (end <= begin || end - begin < sizeof(block_t) * 2) return EL_EINVAL;
+
+    const Guard<Mutex> guard(heap_lock);
+    auto               count = heap_region_count.load();
+    if (count >= CONFIG_EL_HEAP_REGIONS_MAX) return EL_ENOMEM;
+
+    auto* block = reinterpret_cast<block_t*>(begin);
+    block->size = end - begin;
+    block->used = false;
+
+    heap_regions[count] = {reinterpret_cast<uint8_t*>(begin), reinterpret_cast<uint8_t*>(end)};
+    heap_region_count.store(count + 1);
+    return EL_OK;
+}
+
+void* el_heap_malloc(size_t size) {
+    // the common case of nothing lent stays off the lock
+    if (heap_region_count.load() == 0) return nullptr;
+
+    size_t need = sizeof(block_t) + align_up(size ? size : 1);
+
+    const Guard<Mutex> guard(heap_lock);
+    for (size_t i = 0; i < heap_region_count.load(); ++i) {
+        auto* end = reinterpret_cast<block_t*>(heap_regions[i].end);
+        for (auto* block = reinterpret_cast<block_t*>(heap_regions[i].begin); block < end; block = next_of(block)) {
+            if (block->used) continue;
+            merge_free(block, end);
+            if (block->size < need) continue;
+
+            // the tail is split off when it can hold a block of its own
+            if (block->size - need >= sizeof(block_t) * 2) {
+                auto* rest  = reinterpret_cast<block_t*>(reinterpret_cast<uint8_t*>(block) + need);
+                rest->size  = block->size - need;
+                rest->used  = false;
+                block->size = need;
+            }
+            block->used = true;
+            return block + 1;
+        }
+    }
+    return nullptr;
+}
+
+bool el_heap_free(void* ptr) {
+    if (ptr == nullptr || heap_region_count.load() == 0) return false;
+
+    auto* p = static_cast<uint8_t*>(ptr);
+
+    const Guard<Mutex> guard(heap_lock);
+    for (size_t i = 0; i < heap_region_count.load(); ++i) {
+        if (p < heap_regions[i].begin || p >= heap_regions[i].end) continue;
+        (static_cast<block_t*>(ptr) - 1)->used = false;
+        return true;
+    }
+    return false;
+}
+
+void el_heap_get_usage(size_t* lent, size_t* free) {
+    size_t lent_size = 0;
+    size_t free_size = 0;
+
+    const Guard<Mutex> guard(heap_lock);
+    for (size_t i = 0; i < heap_region_count.load(); ++i) {
+        lent_size += heap_regions[i].end - heap_regions[i].begin;
+        auto* end = reinterpret_cast<block_t*>(heap_regions[i].end);
+        for (auto* block = reinterpret_cast<block_t*>(heap_regions[i].begin); block < end; block = next_of(block)) {
+            if (block->used) continue;
+            merge_free(block, end);
+            free_size += block->size - sizeof(block_t);
+        }
+    }
+
+    if (lent) *lent = lent_size;
+    if (free) *free = free_size;
+}
+
+}  // namespace edgelab
@@ -0,0 +1,50 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_HEAP_H_
+#define _EL_HEAP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/el_types.h"
+
+namespace edgelab {
+
+// memory lent at runtime (e.g. the part of the tensor arena a right-sized engine leaves over) that the ports serve
+// el_malloc from before their own heap, lent memory is never taken back
+el_err_code_t el_heap_lend(void* ptr, size_t size);
+
+// nullptr when nothing was lent or no lent block is large enough
+void* el_heap_malloc(size_t size);
+
+// false when ptr was not allocated from lent memory
+bool el_heap_free(void* ptr);
+
+void el_heap_get_usage(size_t* lent, size_t* free);
+
+}  // namespace edgelab
+
+#endif
@@ -0,0 +1,607 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_jpeg.h"
+
+#include <cstring>
+
+#include "core/el_common.h"
+#include "core/el_compiler.h"
+#include "core/el_debug.h"
+#include "core/el_types.h"
+#include "el_cv.h"
+
+namespace edgelab {
+
+namespace jpeg {
+
+constexpr uint8_t HUFF_LUT_BITS = 9;
+
+constexpr uint8_t ZIGZAG[64] = {0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,
+                                12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6,  7,  14, 21, 28,
+                                35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+                                58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63};
+
+// t[n][u] = c(u) / 2 * mean(cos((2x + 1) u pi / 16)) over the 8 / N pixels x of output n in Q11, c(0) = 1 / sqrt(2),
+// an 8 point row is inverse transformed straight to its N point box average (IDCT_8 is the plain 8 point idct)
+constexpr int16_t IDCT_8[8 * 8] = {
+  724, 1004, 946,  851,   724,  569,   392,  200,   724, 851,   392,  -200, -724, -1004, -946, -569,
+  724, 569,  -392, -1004, -724, 200,   946,  851,   724, 200,   -946, -569, 724,  851,   -392, -1004,
+  724, -200, -946, 569,   724,  -851,  -392, 1004,  724, -569,  -392, 1004, -724, -200,  946,  -851,
+  724, -851, 392,  200,   -724, 1004,  -946, 569,   724, -1004, 946,  -851, 724,  -569,  392,  -200};
+constexpr int16_t IDCT_4[4 * 8] = {724, 928,  669, 326,  0, -218, -277, -185, 724, 384,  -669, -787, 0, 526,  277, -76,
+                                   724, -384, -669, 787, 0, -526, 277,  76,   724, -928, 669,  -326, 0, 218,  -277, 185};
+constexpr int16_t IDCT_2[2 * 8] = {724, 656, 0, -230, 0, 154, 0, -131, 724, -656, 0, 230, 0, -154, 0, 131};
+constexpr int16_t IDCT_1[1 * 8] = {724, 0, 0, 0, 0, 0, 0, 0};
+
+struct huff_t {
+    uint16_t lut[1u << HUFF_LUT_BITS];  // (length << 8) | symbol of the codes up to HUFF_LUT_BITS long, 0 if longer
+    int32_t  maxcode[17];               // largest code of each length, -1 if there is none
+    int32_t  delta[17];                 // index in vals of the first code of each length minus that code
+    uint8_t  vals[256];
+    bool     valid;
+};
+
+struct component_t {
+    uint8_t id;
+    uint8_t h;
+    uint8_t v;
+    uint8_t tq;
+    uint8_t td;
+    uint8_t ta;
+    int32_t pred;
+};
+
+struct frame_t {
+    component_t comp[3];
+    uint8_t     ncomp;
+    uint8_t     hmax;
+    uint8_t     vmax;
+    uint16_t    width;
+    uint16_t    height;
+};
+
+struct decoder_t {
+    frame_t        frame;
+    uint16_t       qt[4][64];  // zigzag order
+    bool           qt_valid[4];
+    huff_t         dc[4];
+    huff_t         ac[4];
+    uint16_t       restart;
+    const uint8_t* scan;  // entropy coded data of the scan
+    const uint8_t* end;
+    int32_t        blk[64];
+    uint8_t        plane[3][16 * 16];  // samples of each component in the current mcu
+};
+
+struct bit_reader_t {
+    const uint8_t* p;
+    const uint8_t* end;
+    uint32_t       buf;
+    int32_t        cnt;
+    bool           marker;  // stopped at a marker, zeros are fed from there on
+};
+
+static bool is_sof(uint8_t marker) {
+    return marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+}
+
+// walks the marker segments, p is left past the payload of the returned segment (standalone markers have none)
+static bool next_segment(const uint8_t*& p, const uint8_t* end, uint8_t& marker, const uint8_t*& seg, uint16_t& len) {
+    while (p < end && *p != 0xFF) ++p;
+    while (p < end && *p == 0xFF) ++p;
+    if (p >= end) [[unlikely]]
+        return false;
+
+    marker = *p++;
+    seg    = p;
+    len    = 0;
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD9)) return true;
+
+    if (end - p < 2) [[unlikely]]
+        return false;
+    len = static_cast<uint16_t>(p[0] << 8 | p[1]);
+    if (len < 2 || end - p < len) [[unlikely]]
+        return false;
+
+    seg = p + 2;
+    len -= 2;
+    p += len + 2;
+    return true;
+}
+
+static el_err_code_t parse_frame(const uint8_t* seg, uint16_t len, frame_t* frame) {
+    if (len < 6) [[unlikely]]
+        return EL_EIO;
+    if (seg[0] != 8) return EL_ENOTSUP;
+
+    frame->height = static_cast<uint16_t>(seg[1] << 8 | seg[2]);
+    frame->width  = static_cast<uint16_t>(seg[3] << 8 | seg[4]);
+    frame->ncomp  = seg[5];
+    if (!frame->width || !frame->height) return EL_ENOTSUP;  // the height may be deferred to a DNL marker
+    if (frame->ncomp != 1 && frame->ncomp != 3) return EL_ENOTSUP;
+    if (len < 6 + frame->ncomp * 3) [[unlikely]]
+        return EL_EIO;
+
+    frame->hmax = 1;
+    frame->vmax = 1;
+    for (uint8_t i = 0; i < frame->ncomp; ++i) {
+        auto& c = frame->comp[i];
+        c.id    = seg[6 + i * 3];
+        c.h     = seg[7 + i * 3] >> 4;
+        c.v     = seg[7 + i * 3] & 0x0F;
+        c.tq    = seg[8 + i * 3] & 0x03;
+        // 4:4:4, 4:2:2, 4:4:0 and 4:2:0, a single component scan is always one block per mcu
+        if (frame->ncomp == 1) c.h = c.v = 1;
+        if (c.h < 1 || c.h > 2 || c.v < 1 || c.v > 2) return EL_ENOTSUP;
+        frame->hmax = c.h > frame->hmax ? c.h : frame->hmax;
+        frame->vmax = c.v > frame->vmax ? c.v : frame->vmax;
+    }
+    return EL_OK;
+}
+
+static el_err_code_t parse_quant(const uint8_t* seg, uint16_t len, decoder_t* dec) {
+    while (len) {
+        uint8_t pq = seg[0] >> 4;
+        uint8_t tq = seg[0] & 0x0F;
+        size_t  n  = 1 + 64 * (pq + 1);
+        if (pq > 1 || tq > 3 || len < n) [[unlikely]]
+            return EL_EIO;
+
+        for (uint8_t k = 0; k < 64; ++k)
+            dec->qt[tq][k] = pq ? static_cast<uint16_t>(seg[1 + k * 2] << 8 | seg[2 + k * 2]) : seg[1 + k];
+        dec->qt_valid[tq] = true;
+
+        seg += n;
+        len -= n;
+    }
+    return EL_OK;
+}
+
+static el_err_code_t parse_huffman(const uint8_t* seg, uint16_t len, decoder_t* dec) {
+    while (len) {
+        if (len < 17) [[unlikely]]
+            return EL_EIO;
+        uint8_t tc = seg[0] >> 4;
+        uint8_t th = seg[0] & 0x0F;
+        if (tc > 1 || th > 3) [[unlikely]]
+            return EL_EIO;
+
+        size_t count = 0;
+        for (uint8_t l = 1; l <= 16; ++l) count += seg[l];
+        if (count > 256 || len < 17 + count) [[unlikely]]
+            return EL_EIO;
+
+        auto& h = tc ? dec->ac[th] : dec->dc[th];
+        memset(&h, 0, sizeof(h));
+        memcpy(h.vals, seg + 17, count);
+
+        // canonical codes, the short ones are also spread over every HUFF_LUT_BITS bits prefix they start
+        int32_t code = 0;
+        int32_t k    = 0;
+        for (uint8_t l = 1; l <= 16; ++l) {
+            uint8_t n = seg[l];
+            // more codes of a length than there are left would be spread past the end of the lut
+            if (code + n > (1 << l)) [[unlikely]]
+                return EL_EIO;
+            h.delta[l]   = k - code;
+            h.maxcode[l] = n ? code + n - 1 : -1;
+            for (uint8_t i = 0; i < n; ++i, ++code, ++k) {
+                if (l > HUFF_LUT_BITS) continue;
+                uint16_t shift = HUFF_LUT_BITS - l;
+                for (uint32_t j = 0; j < (1u << shift); ++j)
+                    h.lut[(static_cast<uint32_t>(code) << shift) | j] = static_cast<uint16_t>(l << 8 | h.vals[k]);
+            }
+            code <<= 1;
+        }
+        h.valid = true;
+
+        seg += 17 + count;
+        len -= 17 + count;
+    }
+    return EL_OK;
+}
+
+static el_err_code_t parse_scan(const uint8_t* seg, uint16_t len, decoder_t* dec) {
+    if (len < 1 || len < 4 + seg[0] * 2) [[unlikely]]
+        return EL_EIO;
+    // the components of a baseline frame are expected interleaved in a single scan
+    if (seg[0] != dec->frame.ncomp) return EL_ENOTSUP;
+
+    for (uint8_t i = 0; i < seg[0]; ++i) {
+        component_t* c = nullptr;
+        for (uint8_t j = 0; j < dec->frame.ncomp; ++j)
+            if (dec->frame.comp[j].id == seg[1 + i * 2]) c = &dec->frame.comp[j];
+        if (!c || c != &dec->frame.comp[i]) [[unlikely]]
+            return EL_EIO;
+
+        c->td = seg[2 + i * 2] >> 4;
+        c->ta = seg[2 + i * 2] & 0x0F;
+        if (c->td > 3 || c->ta > 3 || !dec->dc[c->td].valid || !dec->ac[c->ta].valid || !dec->qt_valid[c->tq])
+            [[unlikely]]
+            return EL_EIO;
+    }
+    return EL_OK;
+}
+
+static el_err_code_t parse_headers(const uint8_t* data, size_t size, decoder_t* dec) {
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) [[unlikely]]
+        return EL_EINVAL;
+
+    const uint8_t* p     = data + 2;
+    const uint8_t* end   = data + size;
+    bool           frame = false;
+    uint8_t        marker;
+    const uint8_t* seg;
+    uint16_t       len;
+
+    while (next_segment(p, end, marker, seg, len)) {
+        el_err_code_t ret = EL_OK;
+        switch (marker) {
+        case 0xC0:
+        case 0xC1:
+            ret   = parse_frame(seg, len, &dec->frame);
+            frame = true;
+            break;
+        case 0xC4:
+            ret = parse_huffman(seg, len, dec);
+            break;
+        case 0xDB:
+            ret = parse_quant(seg, len, dec);
+            break;
+        case 0xDD:
+            if (len < 2) [[unlikely]]
+                return EL_EIO;
+            dec->restart = static_cast<uint16_t>(seg[0] << 8 | seg[1]);
+            break;
+        case 0xDA:
+            if (!frame) [[unlikely]]
+                return EL_EIO;
+            ret = parse_scan(seg, len, dec);
+            if (ret != EL_OK) return ret;
+            dec->scan = p;
+            dec->end  = end;
+            return EL_OK;
+        case 0xD9:
+            return EL_EIO;
+        default:
+            if (is_sof(marker) || marker == 0xCC) return EL_ENOTSUP;
+            break;
+        }
+        if (ret != EL_OK) return ret;
+    }
+    return EL_EIO;
+}
+
+EL_ATTR_ALWAYS_INLINE inline void fill_bits(bit_reader_t& br) {
+    while (br.cnt <= 24) {
+        uint32_t b = 0;
+        if (!br.marker && br.p < br.end) {
+            b = *br.p++;
+            if (b == 0xFF) {
+                if (br.p < br.end && *br.p == 0x00) {
+                    ++br.p;
+                } else {
+                    // a marker ends the entropy coded segment, leave it to the restart handling
+                    --br.p;
+                    br.marker = true;
+                    b         = 0;
+                }
+            }
+        }
+        br.buf |= b << (24 - br.cnt);
+        br.cnt += 8;
+    }
+}
+
+EL_ATTR_ALWAYS_INLINE inline int32_t get_bits(bit_reader_t& br, uint8_t n) {
+    fill_bits(br);
+    int32_t v = static_cast<int32_t>(br.buf >> (32 - n));
+    br.buf <<= n;
+    br.cnt -= n;
+    return v;
+}
+
+EL_ATTR_ALWAYS_INLINE inline int32_t extend(int32_t v, uint8_t s) { return v < (1 << (s - 1)) ? v - (1 << s) + 1 : v; }
+
+EL_ATTR_ALWAYS_INLINE inline int32_t decode_symbol(bit_reader_t& br, const huff_t& h) {
+    fill_bits(br);
+    uint16_t e = h.lut[br.buf >> (32 - HUFF_LUT_BITS)];
+    if (e) [[likely]] {
+        br.buf <<= e >> 8;
+        br.cnt -= e >> 8;
+        return e & 0xFF;
+    }
+    for (uint8_t l = HUFF_LUT_BITS + 1; l <= 16; ++l) {
+        int32_t code = static_cast<int32_t>(br.buf >> (32 - l));
+        if (code <= h.maxcode[l]) {
+            br.buf <<= l;
+            br.cnt -= l;
+            return h.vals[code + h.delta[l]];
+        }
+    }
+    return -1;
+}
+
+// resynchronizes on the next RSTn marker, whatever is left of the previous interval is dropped
+static void restart(bit_reader_t& br, decoder_t* dec) {
+    br.buf    = 0;
+    br.cnt    = 0;
+    br.marker = false;
+    while (br.p + 1 < br.end && !(br.p[0] == 0xFF && br.p[1] >= 0xD0 && br.p[1] <= 0xD7)) ++br.p;
+    if (br.p + 1 < br.end) br.p += 2;
+
+    for (uint8_t i = 0; i < dec->frame.ncomp; ++i) dec->frame.comp[i].pred = 0;
+}
+
+// dequantized coefficients in natural order, a block downscaled to a single pixel only needs its dc
+static bool decode_block(bit_reader_t& br, decoder_t* dec, component_t& c, bool dc_only) {
+    const uint16_t* q   = dec->qt[c.tq];
+    int32_t*        blk = dec->blk;
+
+    int32_t t = decode_symbol(br, dec->dc[c.td]);
+    if (t < 0 || t > 11) [[unlikely]]
+        return false;
+    if (t) {
+        int32_t pred = c.pred + extend(get_bits(br, t), t);
+        c.pred       = EL_CLIP(pred, -2047, 2047);
+    }
+
+    if (!dc_only) memset(blk, 0, sizeof(dec->blk));
+    int32_t dc = c.pred * q[0];
+    blk[0]     = EL_CLIP(dc, -8191, 8191);
+
+    const huff_t& ac = dec->ac[c.ta];
+    for (uint8_t k = 1; k < 64;) {
+        int32_t rs = decode_symbol(br, ac);
+        if (rs < 0) [[unlikely]]
+            return false;
+
+        uint8_t r = rs >> 4;
+        uint8_t s = rs & 0x0F;
+        if (s) {
+            k += r;
+            if (k > 63) [[unlikely]]
+                return false;
+            int32_t v = extend(get_bits(br, s), s) * q[k];
+            if (!dc_only) blk[ZIGZAG[k]] = EL_CLIP(v, -8191, 8191);
+            ++k;
+        } else if (r == 15) {
+            k += 16;
+        } else {
+            break;
+        }
+    }
+    return true;
+}
+
+constexpr const int16_t* idct_table(uint8_t n) {
+    return n == 8 ? IDCT_8 : n == 4 ? IDCT_4 : n == 2 ? IDCT_2 : IDCT_1;
+}
+
+// separable idct of an 8 x 8 block into W x H pixels, the first pass keeps 2 fractional bits, coefficients are
+// clipped so that neither pass overflows on corrupt streams
+template <uint8_t W, uint8_t H> static void idct(const int32_t* blk, uint8_t* out, uint16_t stride) {
+    if constexpr (W == 1 && H == 1) {
+        int32_t acc = (blk[0] * 724 + (1 << 8)) >> 9;
+        acc         = (acc * 724 + (128 << 13) + (1 << 12)) >> 13;
+        out[0]      = static_cast<uint8_t>(EL_CLIP(acc, 0, 255));
+        return;
+    }
+
+    constexpr const int16_t* tx = idct_table(W);
+    constexpr const int16_t* ty = idct_table(H);
+    int32_t                  tmp[8 * W];
+
+    for (uint8_t v = 0; v < 8; ++v) {
+        const int32_t* row = blk + v * 8;
+        if (!(row[1] | row[2] | row[3] | row[4] | row[5] | row[6] | row[7])) {
+            int32_t dc = (row[0] * 724 + (1 << 8)) >> 9;
+            for (uint8_t x = 0; x < W; ++x) tmp[v * W + x] = dc;
+            continue;
+        }
+        for (uint8_t x = 0; x < W; ++x) {
+            int32_t acc = 0;
+            for (uint8_t u = 0; u < 8; ++u) acc += row[u] * tx[x * 8 + u];
+            tmp[v * W + x] = (acc + (1 << 8)) >> 9;
+        }
+    }
+
+    for (uint8_t y = 0; y < H; ++y) {
+        for (uint8_t x = 0; x < W; ++x) {
+            int32_t acc = (128 << 13) + (1 << 12);
+            for (uint8_t v = 0; v < 8; ++v) acc += tmp[v * W + x] * ty[y * 8 + v];
+            acc >>= 13;
+            out[y * stride + x] = static_cast<uint8_t>(EL_CLIP(acc, 0, 255));
+        }
+    }
+}
+
+using IdctFn = void (*)(const int32_t* blk, uint8_t* out, uint16_t stride);
+
+// indexed by log2 of the output width and height
+constexpr IdctFn IDCT_FNS[4][4] = {
+  {idct<1, 1>, idct<1, 2>, idct<1, 4>, idct<1, 8>},
+  {idct<2, 1>, idct<2, 2>, idct<2, 4>, idct<2, 8>},
+  {idct<4, 1>, idct<4, 2>, idct<4, 4>, idct<4, 8>},
+  {idct<8, 1>, idct<8, 2>, idct<8, 4>, idct<8, 8>},
+};
+
+constexpr uint8_t log2_of(uint8_t n) { return n == 8 ? 3 : n == 4 ? 2 : n == 2 ? 1 : 0; }
+
+EL_ATTR_ALWAYS_INLINE inline void ycc_to_rgb(int32_t y, int32_t cb, int32_t cr, uint8_t* rgb) {
+    // JFIF full range in Q16, r = y + 1.402 cr, g = y - 0.344136 cb - 0.714136 cr, b = y + 1.772 cb
+    cb -= 128;
+    cr -= 128;
+    y <<= 16;
+
+    int32_t r = (y + 91881 * cr + 32768) >> 16;
+    int32_t g = (y - 22554 * cb - 46802 * cr + 32768) >> 16;
+    int32_t b = (y + 116130 * cb + 32768) >> 16;
+
+    rgb[0] = static_cast<uint8_t>(EL_CLIP(r, 0, 255));
+    rgb[1] = static_cast<uint8_t>(EL_CLIP(g, 0, 255));
+    rgb[2] = static_cast<uint8_t>(EL_CLIP(b, 0, 255));
+}
+
+static el_err_code_t decode_scan(decoder_t* dec, uint8_t scale, el_img_t* dst) {
+    frame_t& f = dec->frame;
+
+    const uint8_t  n       = 8 / scale;
+    const uint16_t mcu_w   = 8 * f.hmax;
+    const uint16_t mcu_h   = 8 * f.vmax;
+    const uint16_t mcus_x  = (f.width + mcu_w - 1) / mcu_w;
+    const uint16_t mcus_y  = (f.height + mcu_h - 1) / mcu_h;
+    const uint16_t out_w   = n * f.hmax;
+    const uint16_t out_h   = n * f.vmax;
+    const bool     gray    = dst->format == EL_PIXEL_FORMAT_GRAYSCALE;
+    const uint8_t  ch      = gray ? 1 : 3;
+    const size_t   pitch   = el_img_pitch(dst);
+    uint32_t       counter = 0;
+
+    // subsampled components are transformed to as many samples as they cover output pixels along each direction (up
+    // to a full block), the planes are then sampled through per component column and row indices
+    uint8_t  bw[3];
+    uint8_t  bh[3];
+    IdctFn   fn[3];
+    uint16_t stride[3];
+    uint8_t  xi[3][16];
+    uint16_t yi[3][16];
+    for (uint8_t i = 0; i < f.ncomp; ++i) {
+        const auto& c = f.comp[i];
+        bw[i]         = EL_MIN(n * (f.hmax / c.h), 8);
+        bh[i]         = EL_MIN(n * (f.vmax / c.v), 8);
+        fn[i]         = IDCT_FNS[log2_of(bw[i])][log2_of(bh[i])];
+        stride[i]     = c.h * bw[i];
+        for (uint16_t x = 0; x < out_w; ++x) xi[i][x] = x * stride[i] / out_w;
+        for (uint16_t y = 0; y < out_h; ++y) yi[i][y] = y * (c.v * bh[i]) / out_h * stride[i];
+    }
+
+    bit_reader_t br{.p = dec->scan, .end = dec->end, .buf = 0, .cnt = 0, .marker = false};
+
+    for (uint16_t my = 0; my < mcus_y; ++my) {
+        for (uint16_t mx = 0; mx < mcus_x; ++mx) {
+            if (dec->restart && counter && counter % dec->restart == 0) restart(br, dec);
+            ++counter;
+
+            for (uint8_t i = 0; i < f.ncomp; ++i) {
+                auto& c = f.comp[i];
+                for (uint8_t by = 0; by < c.v; ++by) {
+                    for (uint8_t bx = 0; bx < c.h; ++bx) {
+                        if (!decode_block(br, dec, c, bw[i] == 1 && bh[i] == 1)) [[unlikely]]
+                            return EL_EIO;
+                        fn[i](dec->blk, dec->plane[i] + by * bh[i] * stride[i] + bx * bw[i], stride[i]);
+                    }
+                }
+            }
+
+            uint16_t x0 = mx * out_w;
+            uint16_t y0 = my * out_h;
+            uint16_t w  = x0 + out_w > dst->width ? dst->width - x0 : out_w;
+            uint16_t h  = y0 + out_h > dst->height ? dst->height - y0 : out_h;
+
+            for (uint16_t y = 0; y < h; ++y) {
+                uint8_t*       d  = dst->data + (y0 + y) * pitch + x0 * ch;
+                const uint8_t* py = dec->plane[0] + yi[0][y];
+                if (gray) {
+                    for (uint16_t x = 0; x < w; ++x) d[x] = py[xi[0][x]];
+                    continue;
+                }
+                if (f.ncomp == 1) {
+                    for (uint16_t x = 0; x < w; ++x, d += 3) d[0] = d[1] = d[2] = py[xi[0][x]];
+                    continue;
+                }
+                const uint8_t* pb = dec->plane[1] + yi[1][y];
+                const uint8_t* pr = dec->plane[2] + yi[2][y];
+                for (uint16_t x = 0; x < w; ++x, d += 3) ycc_to_rgb(py[xi[0][x]], pb[xi[1][x]], pr[xi[2][x]], d);
+            }
+        }
+    }
+
+    return EL_OK;
+}
+
+}  // namespace jpeg
+
+using namespace edgelab::jpeg;
+
+el_err_code_t el_jpeg_get_info(const uint8_t* data, size_t size, el_jpeg_info_t* info) {
+    if (!data || !info) [[unlikely]]
+        return EL_EINVAL;
+    if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) [[unlikely]]
+        return EL_EINVAL;
+
+    const uint8_t* p   = data + 2;
+    const uint8_t* end = data + size;
+    uint8_t        marker;
+    const uint8_t* seg;
+    uint16_t       len;
+
+    while (next_segment(p, end, marker, seg, len)) {
+        if (marker == 0xDA || marker == 0xD9) [[unlikely]]
+            break;
+        if (!is_sof(marker)) continue;
+        if (marker != 0xC0 && marker != 0xC1) return EL_ENOTSUP;
+
+
+        frame_t frame{};
+        auto    ret = parse_frame(seg, len, &frame);
+        if (ret != EL_OK) return ret;
+
+        info->width      = frame.width;
+        info->height     = frame.height;
+        info->components = frame.ncomp;
+        return EL_OK;
+    }
+    return EL_EIO;
+}
+
+el_err_code_t el_jpeg_decode(const uint8_t* data, size_t size, uint8_t scale, el_img_t* dst) {
+    if (!data || !dst || !dst->data) [[unlikely]]
+        return EL_EINVAL;
+    if (scale != 1 && scale != 2 && scale != 4 && scale != 8) [[unlikely]]
+        return EL_EINVAL;
+    if (dst->format != EL_PIXEL_FORMAT_RGB888 && dst->format != EL_PIXEL_FORMAT_GRAYSCALE) return EL_ENOTSUP;
+    if (dst->rotate != EL_PIXEL_ROTATE_0) return EL_ENOTSUP;
+
+    auto* dec = static_cast<decoder_t*>(el_malloc(sizeof(decoder_t)));
+    if (!dec) [[unlikely]]
+        return EL_ENOMEM;
+    memset(dec, 0, sizeof(decoder_t));
+
+    auto ret = parse_headers(data, size, dec);
+    if (ret == EL_OK) {
+        const auto& f = dec->frame;
+        if (dst->width != (f.width + scale - 1) / scale || dst->height != (f.height + scale - 1) / scale ||
+            el_img_pitch(dst) * (dst->height - 1) + dst->width * el_img_bpp(dst->format) > dst->size) [[unlikely]]
+            ret = EL_EINVAL;
+    }
+    if (ret == EL_OK) ret = decode_scan(dec, scale, dst);
+
+    el_free(dec);
+    return ret;
+}
+
+}  // namespace edgelab
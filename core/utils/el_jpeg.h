@@ -0,0 +1,57 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_JPEG_H_
+#define _EL_JPEG_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/el_types.h"
+
+namespace edgelab {
+
+namespace types {
+
+typedef struct el_jpeg_info_t {
+    uint16_t width;
+    uint16_t height;
+    uint8_t  components;  // 1 for grayscale, 3 for YCbCr
+} el_jpeg_info_t;
+
+}  // namespace types
+
+using namespace edgelab::types;
+
+// reads the frame header of a baseline jpeg, progressive, arithmetic coded and 12-bit streams are not supported
+el_err_code_t el_jpeg_get_info(const uint8_t* data, size_t size, el_jpeg_info_t* info);
+
+// decodes a baseline jpeg into an RGB888 or grayscale image, scale (1, 2, 4 or 8) is applied in the idct which
+// transforms each block straight to its box downscale, dst must be ceil(width / scale) x ceil(height / scale)
+el_err_code_t el_jpeg_decode(const uint8_t* data, size_t size, uint8_t scale, el_img_t* dst);
+
+}  // namespace edgelab
+
+#endif
@@ -120,6 +120,7 @@ el_err_code_t CameraEsp::get_frame(el_img_t* img) {
     img->data   = fb->buf;
     img->size   = fb->len;
     img->format = EL_PIXEL_FORMAT_RGB565;
+    img->pitch  = 0;
     return EL_OK;
 }
 
@@ -31,8 +31,10 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 
 #include "core/el_compiler.h"
+#include "core/utils/el_heap.h"
 #include "el_config_porting.h"
 #include "porting/el_misc.h"
 
@@ -53,7 +55,10 @@ EL_ATTR_WEAK int el_printf(const char* fmt, ...) {
 
 EL_ATTR_WEAK int el_putchar(char c) { return putchar(c); }
 
-EL_ATTR_WEAK void* el_malloc(size_t size) { return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT); }
+EL_ATTR_WEAK void* el_malloc(size_t size) {
+    void* p = edgelab::el_heap_malloc(size);
+    return p ? p : heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
 
 EL_ATTR_WEAK void* el_aligned_malloc_once(size_t align, size_t size) {
     void*  p = el_malloc(size + align);
@@ -61,9 +66,17 @@ EL_ATTR_WEAK void* el_aligned_malloc_once(size_t align, size_t size) {
     return p + o;
 }
 
-EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) { return calloc(nmemb, size); }
+EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) {
+    // a wrapped product would be served from lent memory as a block too small for the caller
+    if (size && nmemb > SIZE_MAX / size) [[unlikely]]
+        return nullptr;
+    void* p = edgelab::el_heap_malloc(nmemb * size);
+    return p ? std::memset(p, 0, nmemb * size) : calloc(nmemb, size);
+}
 
-EL_ATTR_WEAK void el_free(void* ptr) { free(ptr); }
+EL_ATTR_WEAK void el_free(void* ptr) {
+    if (!edgelab::el_heap_free(ptr)) free(ptr);
+}
 
 EL_ATTR_WEAK void el_reset(void) { exit(0); }
 
@@ -84,6 +84,7 @@ el_err_code_t CameraWE1::get_frame(el_img_t* img) {
     img->data   = reinterpret_cast<uint8_t*>(yuv422_addr);
     img->size   = img->width * img->height * 2;
     img->format = EL_PIXEL_FORMAT_YUV422;
+    img->pitch  = 0;
 
     return EL_OK;
 }
@@ -102,6 +103,7 @@ el_err_code_t CameraWE1::get_processed_frame(el_img_t* img) {
     img->data   = (uint8_t*)jpeg_addr;
     img->size   = jpeg_size;
     img->format = EL_PIXEL_FORMAT_JPEG;
+    img->pitch  = 0;
 
     return EL_OK;
 }
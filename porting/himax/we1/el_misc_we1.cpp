@@ -35,9 +35,11 @@ extern "C" {
 #include <cstdarg>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
 #include "core/el_debug.h"
 #include "core/el_types.h"
+#include "core/utils/el_heap.h"
 #include "el_config_porting.h"
 #include "porting/el_misc.h"
 
@@ -60,11 +62,22 @@ EL_ATTR_WEAK int el_printf(const char* fmt, ...) {
 
 EL_ATTR_WEAK int el_putchar(char c) { return console_putchar(c); }
 
-EL_ATTR_WEAK void* el_malloc(size_t size) { return malloc(size); }
+EL_ATTR_WEAK void* el_malloc(size_t size) {
+    void* p = edgelab::el_heap_malloc(size);
+    return p ? p : malloc(size);
+}
 
-EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) { return calloc(nmemb, size); }
+EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) {
+    // a wrapped product would be served from lent memory as a block too small for the caller
+    if (size && nmemb > SIZE_MAX / size) [[unlikely]]
+        return nullptr;
+    void* p = edgelab::el_heap_malloc(nmemb * size);
+    return p ? std::memset(p, 0, nmemb * size) : calloc(nmemb, size);
+}
 
-EL_ATTR_WEAK void el_free(void* ptr) { free(ptr); }
+EL_ATTR_WEAK void el_free(void* ptr) {
+    if (!edgelab::el_heap_free(ptr)) free(ptr);
+}
 
 EL_ATTR_WEAK void el_reset(void) { exit(0); }
 
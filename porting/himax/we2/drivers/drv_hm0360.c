@@ -154,6 +154,7 @@ el_err_code_t drv_hm0360_init(uint16_t width, uint16_t height) {
     _frame.width  = width;
     _frame.rotate = EL_PIXEL_ROTATE_0;
     _frame.format = EL_PIXEL_FORMAT_YUV422;
+    _frame.pitch  = 0;
 
     _jpeg.data   = _wdma2_baseaddr;
     _jpeg.size   = width * height / 4;
@@ -161,6 +162,7 @@ el_err_code_t drv_hm0360_init(uint16_t width, uint16_t height) {
     _jpeg.width  = width;
     _jpeg.rotate = EL_PIXEL_ROTATE_0;
     _jpeg.format = EL_PIXEL_FORMAT_JPEG;
+    _jpeg.pitch  = 0;
 
     // datapath init
 
@@ -264,12 +264,14 @@ el_err_code_t drv_ov5647_init(uint16_t width, uint16_t height) {
     _frame.width  = width;
     _frame.rotate = EL_PIXEL_ROTATE_0;
     _frame.format = EL_PIXEL_FORMAT_YUV422;
+    _frame.pitch  = 0;
     _frame.size   = width * height * 3 / 2;
 
     _jpeg.height = height;
     _jpeg.width  = width;
     _jpeg.rotate = EL_PIXEL_ROTATE_0;
     _jpeg.format = EL_PIXEL_FORMAT_JPEG;
+    _jpeg.pitch  = 0;
     _jpeg.size   = width * height / 4;
 
     // DMA
@@ -32,9 +32,11 @@ extern "C" {
 #include <cstdarg>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
 #include "core/el_debug.h"
 #include "core/el_types.h"
+#include "core/utils/el_heap.h"
 #include "el_config_porting.h"
 #include "porting/el_misc.h"
 
@@ -76,6 +78,7 @@ EL_ATTR_WEAK int el_printf(const char* fmt, ...) {
 EL_ATTR_WEAK int el_putchar(char c) { return 0; }
 
 EL_ATTR_WEAK void* el_malloc(size_t size) {
+    if (void* p = edgelab::el_heap_malloc(size); p) return p;
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
     return pvPortMalloc(size);
 #else
@@ -99,6 +102,10 @@ EL_ATTR_WEAK void* el_aligned_malloc_once(size_t align, size_t size) {
 }
 
 EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) {
+    // a wrapped product would be served from lent memory as a block too small for the caller
+    if (size && nmemb > SIZE_MAX / size) [[unlikely]]
+        return nullptr;
+    if (void* p = edgelab::el_heap_malloc(nmemb * size); p) return std::memset(p, 0, nmemb * size);
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
     return pvPortMalloc(nmemb * size);
 #else
@@ -107,6 +114,7 @@ EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) {
 }
 
 EL_ATTR_WEAK void el_free(void* ptr) {
+    if (edgelab::el_heap_free(ptr)) return;
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
     vPortFree(ptr);
 #else
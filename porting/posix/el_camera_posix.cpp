@@ -0,0 +1,316 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_camera_posix.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "core/el_debug.h"
+#include "core/utils/el_cv.h"
+#include "core/utils/el_jpeg.h"
+#include "el_config_porting.h"
+#include "el_device_posix.h"
+#include "porting/el_misc.h"
+
+namespace edgelab {
+
+namespace porting {
+
+struct raw_format_t {
+    const char*       extension;
+    el_pixel_format_t format;
+};
+
+constexpr raw_format_t RAW_FORMATS[] = {
+  {".rgb888", EL_PIXEL_FORMAT_RGB888},
+  {".rgb565", EL_PIXEL_FORMAT_RGB565},
+  {  ".gray", EL_PIXEL_FORMAT_GRAYSCALE},
+  {".yuv422", EL_PIXEL_FORMAT_YUV422},
+  {  ".yuyv", EL_PIXEL_FORMAT_YUYV},
+  {  ".uyvy", EL_PIXEL_FORMAT_UYVY},
+  {  ".nv12", EL_PIXEL_FORMAT_NV12},
+  {  ".nv21", EL_PIXEL_FORMAT_NV21},
+};
+
+static bool has_extension(const std::string& path, const char* extension) {
+    size_t n = std::strlen(extension);
+    if (path.size() < n) return false;
+    return std::equal(path.end() - n, path.end(), extension, [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == b;
+    });
+}
+
+static size_t raw_frame_size(el_pixel_format_t format, uint16_t width, uint16_t height) {
+    size_t area = static_cast<size_t>(width) * height;
+    switch (format) {
+    case EL_PIXEL_FORMAT_NV12:
+    case EL_PIXEL_FORMAT_NV21:
+        return area + (area >> 1);
+    case EL_PIXEL_FORMAT_YUV422:
+        return area * 2;
+    default:
+        return area * el_img_bpp(format);
+    }
+}
+
+// binary ppm (P6) and pgm (P5) headers with 8-bit samples, returns the offset of the pixels or 0
+static size_t parse_pnm(int fd, uint16_t* width, uint16_t* height, el_pixel_format_t* format) {
+    char    head[256]{};
+    ssize_t n = pread(fd, head, sizeof(head) - 1, 0);
+    if (n < 3 || head[0] != 'P' || (head[1] != '5' && head[1] != '6')) return 0;
+
+    // magic, width, height and maxval separated by white space, comments run to the end of their line
+    uint32_t fields[3]{};
+    size_t   pos = 2;
+    for (auto& field : fields) {
+        while (pos < static_cast<size_t>(n) && (std::isspace(static_cast<unsigned char>(head[pos])) || head[pos] == '#'))
+            if (head[pos++] == '#')
+                while (pos < static_cast<size_t>(n) && head[pos] != '\n') ++pos;
+        if (pos >= static_cast<size_t>(n) || !std::isdigit(static_cast<unsigned char>(head[pos]))) return 0;
+        while (pos < static_cast<size_t>(n) && std::isdigit(static_cast<unsigned char>(head[pos])))
+            field = field * 10 + (head[pos++] - '0');
+    }
+    // a single white space character ends the header
+    if (++pos > static_cast<size_t>(n) || fields[2] != 255 || !fields[0] || !fields[1] || fields[0] > UINT16_MAX ||
+        fields[1] > UINT16_MAX)
+        return 0;
+
+    *width  = fields[0];
+    *height = fields[1];
+    *format = head[1] == '6' ? EL_PIXEL_FORMAT_RGB888 : EL_PIXEL_FORMAT_GRAYSCALE;
+    return pos;
+}
+
+}  // namespace porting
+
+CameraPosix::CameraPosix()
+    : _frames(), _index(0), _buf(nullptr), _capacity(0), _frame{}, _period_us(0), _next_us(0) {}
+
+CameraPosix::~CameraPosix() { deinit(); }
+
+void CameraPosix::add_file(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) [[unlikely]]
+        return;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !st.st_size) [[unlikely]] {
+        close(fd);
+        return;
+    }
+    size_t file_size = static_cast<size_t>(st.st_size);
+
+    frame_t frame{.path = path, .offset = 0, .size = 0, .width = 0, .height = 0, .format = EL_PIXEL_FORMAT_UNKNOWN};
+
+    if (porting::has_extension(path, ".jpg") || porting::has_extension(path, ".jpeg")) {
+        // the header is searched for in the first kilobytes, the whole file is the frame
+        uint8_t        head[64 * 1024];
+        ssize_t        n = pread(fd, head, sizeof(head), 0);
+        el_jpeg_info_t info;
+        if (n > 0 && el_jpeg_get_info(head, static_cast<size_t>(n), &info) == EL_OK) {
+            frame.size   = file_size;
+            frame.width  = info.width;
+            frame.height = info.height;
+            frame.format = EL_PIXEL_FORMAT_JPEG;
+            _frames.push_back(frame);
+        } else
+            EL_LOGW("[Camera] skipping %s, not a baseline jpeg", path.c_str());
+    } else if (porting::has_extension(path, ".ppm") || porting::has_extension(path, ".pgm")) {
+        frame.offset = porting::parse_pnm(fd, &frame.width, &frame.height, &frame.format);
+        frame.size   = porting::raw_frame_size(frame.format, frame.width, frame.height);
+        if (frame.offset && frame.offset + frame.size <= file_size)
+            _frames.push_back(frame);
+        else
+            EL_LOGW("[Camera] skipping %s, not a binary 8-bit ppm or pgm", path.c_str());
+    } else {
+        for (const auto& raw : porting::RAW_FORMATS) {
+            if (!porting::has_extension(path, raw.extension)) continue;
+
+            unsigned w = 0;
+            unsigned h = 0;
+            if (std::sscanf(EL_POSIX_OPTION(CONFIG_EL_POSIX_CAMERA_RAW_SIZE), "%ux%u", &w, &h) != 2 || !w || !h ||
+                w > UINT16_MAX || h > UINT16_MAX) {
+                EL_LOGW("[Camera] skipping %s, invalid raw size", path.c_str());
+                break;
+            }
+            frame.width  = w;
+            frame.height = h;
+            frame.format = raw.format;
+            frame.size   = porting::raw_frame_size(frame.format, frame.width, frame.height);
+
+            // a dump holds as many whole frames as fit in the file
+            for (frame.offset = 0; frame.offset + frame.size <= file_size; frame.offset += frame.size)
+                _frames.push_back(frame);
+            if (file_size < frame.size) EL_LOGW("[Camera] skipping %s, shorter than a frame", path.c_str());
+            break;
+        }
+    }
+
+    close(fd);
+}
+
+el_err_code_t CameraPosix::init(size_t width, size_t height) {
+    // the resolution is that of the replayed frames
+    (void)width;
+    (void)height;
+
+    _frames.clear();
+    _index = 0;
+
+    std::string source = EL_POSIX_OPTION(CONFIG_EL_POSIX_CAMERA_SOURCE);
+    struct stat st;
+    if (stat(source.c_str(), &st) != 0) {
+        EL_ELOG("[Camera] source %s not found", source.c_str());
+        return EL_EIO;
+    }
+
+    if (S_ISDIR(st.st_mode)) {
+        std::vector<std::string> names;
+        if (DIR* dir = opendir(source.c_str())) {
+            while (const struct dirent* entry = readdir(dir))
+                if (entry->d_name[0] != '.') names.emplace_back(entry->d_name);
+            closedir(dir);
+        }
+        std::sort(names.begin(), names.end());
+        for (const auto& name : names) add_file(source + "/" + name);
+    } else
+        add_file(source);
+
+    if (_frames.empty()) {
+        EL_ELOG("[Camera] no frame found in %s", source.c_str());
+        return EL_EIO;
+    }
+
+    uint32_t fps = std::strtoul(EL_POSIX_OPTION(CONFIG_EL_POSIX_CAMERA_FPS), nullptr, 10);
+    _period_us   = fps ? 1000000u / fps : 0;
+    _next_us     = 0;
+
+    EL_LOGI("[Camera] replaying %u frames from %s at %u fps", static_cast<unsigned>(_frames.size()), source.c_str(), fps);
+
+    this->_is_present = true;
+
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::deinit() {
+    if (_buf) el_free(_buf);
+
+    _buf      = nullptr;
+    _capacity = 0;
+    _frames.clear();
+
+    this->_is_streaming = false;
+    this->_is_present   = false;
+
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::load(const frame_t& frame) {
+    if (frame.size > _capacity) {
+        if (_buf) el_free(_buf);
+        _buf      = static_cast<uint8_t*>(el_malloc(frame.size));
+        _capacity = _buf ? frame.size : 0;
+        if (!_buf) [[unlikely]]
+            return EL_ENOMEM;
+    }
+
+    int fd = open(frame.path.c_str(), O_RDONLY);
+    if (fd < 0) [[unlikely]]
+        return EL_EIO;
+    ssize_t n = pread(fd, _buf, frame.size, frame.offset);
+    close(fd);
+    if (n != static_cast<ssize_t>(frame.size)) [[unlikely]]
+        return EL_EIO;
+
+    _frame        = el_img_t{};
+    _frame.data   = _buf;
+    _frame.size   = frame.size;
+    _frame.width  = frame.width;
+    _frame.height = frame.height;
+    _frame.format = frame.format;
+    _frame.rotate = EL_PIXEL_ROTATE_0;
+    _frame.pitch  = 0;
+
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::start_stream() {
+    if (!this->_is_present) [[unlikely]]
+        return EL_EIO;
+
+    // frames are handed out no faster than the configured rate, a late consumer does not get a burst
+    if (_period_us) {
+        uint64_t now = el_get_time_us();
+        if (_next_us > now) el_sleep(static_cast<uint32_t>((_next_us - now + 999) / 1000));
+        _next_us = EL_MAX(_next_us, now) + _period_us;
+    }
+
+    auto ret = load(_frames[_index]);
+    if (ret != EL_OK) {
+        EL_ELOG("[Camera] capture failed");
+        return ret;
+    }
+
+    this->_is_streaming = true;
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::stop_stream() {
+    if (this->_is_streaming) [[likely]] {
+        _index              = (_index + 1) % _frames.size();
+        this->_is_streaming = false;
+        return EL_OK;
+    }
+    return EL_ELOG;
+}
+
+el_err_code_t CameraPosix::get_frame(el_img_t* img) {
+    if (!this->_is_streaming) {
+        return EL_EIO;
+    }
+    *img = _frame;
+    return EL_OK;
+}
+
+// jpeg sources are already compressed, the others are left to the software encoder
+el_err_code_t CameraPosix::get_processed_frame(el_img_t* img) {
+    if (!this->_is_streaming) {
+        return EL_EIO;
+    }
+    if (_frame.format != EL_PIXEL_FORMAT_JPEG) return EL_ENOTSUP;
+    *img = _frame;
+    return EL_OK;
+}
+
+}  // namespace edgelab
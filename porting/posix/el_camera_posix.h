@@ -0,0 +1,79 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_CAMERA_POSIX_H_
+#define _EL_CAMERA_POSIX_H_
+
+#include <string>
+#include <vector>
+
+#include "core/el_types.h"
+#include "porting/el_camera.h"
+
+namespace edgelab {
+
+// replays baseline jpeg, binary ppm / pgm images and raw frame dumps (.rgb888, .rgb565, .gray, .yuv422, .yuyv,
+// .uyvy, .nv12, .nv21, frames of the configured raw size back to back) in file name order, looping at the end
+class CameraPosix final : public Camera {
+   public:
+    CameraPosix();
+    ~CameraPosix() override;
+
+    el_err_code_t init(size_t width, size_t height) override;
+    el_err_code_t deinit() override;
+
+    el_err_code_t start_stream() override;
+    el_err_code_t stop_stream() override;
+
+    el_err_code_t get_frame(el_img_t* img) override;
+    el_err_code_t get_processed_frame(el_img_t* img) override;
+
+   private:
+    struct frame_t {
+        std::string       path;
+        size_t            offset;
+        size_t            size;
+        uint16_t          width;
+        uint16_t          height;
+        el_pixel_format_t format;
+    };
+
+    void          add_file(const std::string& path);
+    el_err_code_t load(const frame_t& frame);
+
+    std::vector<frame_t> _frames;
+    size_t               _index;
+
+    uint8_t* _buf;
+    size_t   _capacity;
+    el_img_t _frame;
+
+    uint64_t _period_us;  // 0 replays as fast as the frames are consumed
+    uint64_t _next_us;
+};
+
+}  // namespace edgelab
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_device_posix.h"
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "el_camera_posix.h"
+#include "el_network_posix.h"
+#include "el_serial_posix.h"
+
+namespace edgelab {
+
+namespace porting {
+
+const char* el_posix_option(const char* name, const char* fallback) {
+    const char* value = std::getenv(name);
+    return value && *value ? value : fallback;
+}
+
+static inline uint32_t _device_id_from_host() {
+    char name[256]{};
+    if (gethostname(name, sizeof(name) - 1) != 0) [[unlikely]]
+        return 0ul;
+
+    // Fowler–Noll–Vo hash function
+    uint32_t hash  = 0x811c9dc5;
+    uint32_t prime = 0x1000193;
+    for (size_t i = 0; name[i]; ++i) {
+        uint8_t value = name[i];
+        hash          = hash ^ value;
+        hash *= prime;
+    }
+
+    return hash;
+}
+
+}  // namespace porting
+
+DevicePosix::DevicePosix() { init(); }
+
+void DevicePosix::init() {
+    this->_device_name = PORT_DEVICE_NAME;
+    this->_device_id   = porting::_device_id_from_host();
+    this->_revision_id = 0;
+
+    static uint8_t sensor_id = 0;
+
+    static CameraPosix camera{};
+    this->_camera = &camera;
+    this->_registered_sensors.emplace_front(el_sensor_info_t{
+      .id = ++sensor_id, .type = el_sensor_type_t::EL_SENSOR_TYPE_CAM, .state = el_sensor_state_t::EL_SENSOR_STA_REG});
+
+    static SerialPosix serial{};
+    this->_serial = &serial;
+
+    static NetworkPosix network{};
+    this->_network = &network;
+}
+
+void DevicePosix::reset() { exit(0); }
+
+Device* Device::get_device() {
+    static DevicePosix device{};
+    return &device;
+}
+
+}  // namespace edgelab
@@ -0,0 +1,55 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_DEVICE_POSIX_H_
+#define _EL_DEVICE_POSIX_H_
+
+#include "porting/el_device.h"
+
+// value of a CONFIG_EL_POSIX_* option, the environment variable of the same name takes precedence
+#define EL_POSIX_OPTION(name) edgelab::porting::el_posix_option(#name, name)
+
+namespace edgelab {
+
+namespace porting {
+
+const char* el_posix_option(const char* name, const char* fallback);
+
+}  // namespace porting
+
+class DevicePosix final : public Device {
+   public:
+    DevicePosix();
+
+    ~DevicePosix() = default;
+
+    void init();
+
+    void reset() override;
+};
+
+}  // namespace edgelab
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "core/el_debug.h"
+#include "core/el_types.h"
+#include "core/synchronize/el_guard.hpp"
+#include "core/synchronize/el_mutex.hpp"
+#include "el_config_porting.h"
+#include "el_device_posix.h"
+#include "porting/el_flash.h"
+
+namespace edgelab {
+
+namespace porting {
+
+// the model partition is a file mapped read only, the handler is its descriptor
+static const uint8_t* _el_flash_mmap      = nullptr;
+static size_t         _el_flash_mmap_size = 0;
+
+bool el_flash_mmap_init(uint32_t* flash_addr, uint32_t* size, const uint8_t** mmap, uint32_t* handler) {
+    const char* path = EL_POSIX_OPTION(CONFIG_EL_POSIX_MODEL_FILE);
+    int         fd   = open(path, O_RDONLY);
+    if (fd < 0) [[unlikely]] {
+        EL_LOGI("[Flash] model file %s not found", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !st.st_size) [[unlikely]] {
+        close(fd);
+        return false;
+    }
+
+    void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) [[unlikely]] {
+        close(fd);
+        return false;
+    }
+
+    _el_flash_mmap      = static_cast<const uint8_t*>(addr);
+    _el_flash_mmap_size = static_cast<size_t>(st.st_size);
+
+    *flash_addr = 0;
+    *size       = static_cast<uint32_t>(_el_flash_mmap_size);
+    *mmap       = _el_flash_mmap;
+    *handler    = static_cast<uint32_t>(fd);
+
+    return true;
+}
+
+void el_flash_mmap_deinit(uint32_t* handler) {
+    if (_el_flash_mmap) munmap(const_cast<uint8_t*>(_el_flash_mmap), _el_flash_mmap_size);
+    _el_flash_mmap      = nullptr;
+    _el_flash_mmap_size = 0;
+    close(static_cast<int>(*handler));
+}
+
+#if CONFIG_EL_LIB_FLASHDB
+
+// the storage partition is a file of the partition size that behaves like nor flash, erasing sets bytes to 0xff
+// and writing can only clear bits
+static Mutex _el_flash_lock{};
+static int   _el_flash_db_fd = -1;
+
+static int _el_flash_db_init(void) {
+    const char* path = EL_POSIX_OPTION(CONFIG_EL_POSIX_STORAGE_FILE);
+    _el_flash_db_fd  = open(path, O_RDWR | O_CREAT, 0644);
+    EL_ASSERT(_el_flash_db_fd >= 0);
+
+    struct stat st;
+    if (fstat(_el_flash_db_fd, &st) == 0 && st.st_size < CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0) {
+        uint8_t blank[FDB_BLOCK_SIZE];
+        std::memset(blank, 0xff, sizeof(blank));
+        for (off_t offset = st.st_size; offset < CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0; offset += sizeof(blank)) {
+            size_t n = EL_MIN(sizeof(blank), static_cast<size_t>(CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0 - offset));
+            if (pwrite(_el_flash_db_fd, blank, n, offset) != static_cast<ssize_t>(n)) return 0;
+        }
+    }
+    return 1;
+}
+
+static int _el_flash_db_read(long offset, uint8_t* buf, size_t size) {
+    const Guard<Mutex> guard(_el_flash_lock);
+    return pread(_el_flash_db_fd, buf, size, offset) == static_cast<ssize_t>(size) ? 0 : -1;
+}
+
+static int _el_flash_db_write(long offset, const uint8_t* buf, size_t size) {
+    const Guard<Mutex> guard(_el_flash_lock);
+    uint8_t            chunk[256];
+    for (size_t done = 0; done < size;) {
+        size_t n = EL_MIN(sizeof(chunk), size - done);
+        if (pread(_el_flash_db_fd, chunk, n, offset + done) != static_cast<ssize_t>(n)) return -1;
+        for (size_t i = 0; i < n; ++i) chunk[i] &= buf[done + i];
+        if (pwrite(_el_flash_db_fd, chunk, n, offset + done) != static_cast<ssize_t>(n)) return -1;
+        done += n;
+    }
+    return 0;
+}
+
+static int _el_flash_db_erase(long offset, size_t size) {
+    const Guard<Mutex> guard(_el_flash_lock);
+    int32_t            erase_size = ((size - 1) / FDB_BLOCK_SIZE) + 1;
+    uint8_t            blank[FDB_BLOCK_SIZE];
+    std::memset(blank, 0xff, sizeof(blank));
+    for (int32_t i = 0; i < erase_size; ++i)
+        if (pwrite(_el_flash_db_fd, blank, sizeof(blank), offset + i * FDB_BLOCK_SIZE) != sizeof(blank)) return -1;
+    return 0;
+}
+
+extern "C" const struct fal_flash_dev _el_flash_db_nor_flash0 = {
+  .name       = CONFIG_EL_STORAGE_PARTITION_MOUNT_POINT,
+  .addr       = 0x00000000,
+  .len        = CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0,
+  .blk_size   = FDB_BLOCK_SIZE,
+  .ops        = {_el_flash_db_init, _el_flash_db_read, _el_flash_db_write, _el_flash_db_erase},
+  .write_gran = FDB_WRITE_GRAN,
+};
+
+#endif
+
+}  // namespace porting
+
+}  // namespace edgelab
@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "core/el_compiler.h"
+#include "core/utils/el_heap.h"
+#include "el_config_porting.h"
+#include "porting/el_misc.h"
+
+EL_ATTR_WEAK void el_sleep(uint32_t ms) {
+    struct timespec ts {
+        .tv_sec = static_cast<time_t>(ms / 1000), .tv_nsec = static_cast<long>(ms % 1000) * 1000000L
+    };
+    while (nanosleep(&ts, &ts) != 0)
+        ;
+}
+
+EL_ATTR_WEAK uint64_t el_get_time_ms(void) { return el_get_time_us() / 1000; }
+
+EL_ATTR_WEAK uint64_t el_get_time_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000u + static_cast<uint64_t>(ts.tv_nsec) / 1000u;
+}
+
+EL_ATTR_WEAK int el_printf(const char* fmt, ...) {
+    va_list args;
+    int     n;
+    va_start(args, fmt);
+    n = vprintf(fmt, args);
+    va_end(args);
+    fflush(stdout);
+    return n;
+}
+
+EL_ATTR_WEAK int el_putchar(char c) { return putchar(c); }
+
+EL_ATTR_WEAK void* el_malloc(size_t size) {
+    void* p = edgelab::el_heap_malloc(size);
+    return p ? p : malloc(size);
+}
+
+// never freed, as on the targets where it is carved from a static heap
+EL_ATTR_WEAK void* el_aligned_malloc_once(size_t align, size_t size) {
+    void* p = nullptr;
+    return posix_memalign(&p, align < sizeof(void*) ? sizeof(void*) : align, size) == 0 ? p : nullptr;
+}
+
+EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) {
+    // a wrapped product would be served from lent memory as a block too small for the caller
+    if (size && nmemb > SIZE_MAX / size) [[unlikely]]
+        return nullptr;
+    void* p = edgelab::el_heap_malloc(nmemb * size);
+    return p ? std::memset(p, 0, nmemb * size) : calloc(nmemb, size);
+}
+
+EL_ATTR_WEAK void el_free(void* ptr) {
+    if (!edgelab::el_heap_free(ptr)) free(ptr);
+}
+
+EL_ATTR_WEAK void el_reset(void) { exit(0); }
+
+// there is no status led on a host
+EL_ATTR_WEAK void el_status_led(bool on) { (void)on; }
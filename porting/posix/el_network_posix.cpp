@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_network_posix.h"
+
+namespace edgelab {
+
+void NetworkPosix::init(status_cb_t cb) {
+    this->status_cb = cb;
+    set_status(NETWORK_LOST);
+}
+
+void NetworkPosix::deinit() { set_status(NETWORK_LOST); }
+
+el_err_code_t NetworkPosix::join(const char* /*ssid*/, const char* /*pwd*/) { return EL_ENOTSUP; }
+
+el_err_code_t NetworkPosix::quit() { return EL_OK; }
+
+el_err_code_t NetworkPosix::set_mdns(mdns_record_t /*record*/) { return EL_ENOTSUP; }
+
+el_err_code_t NetworkPosix::connect(mqtt_server_config_t /*mqtt_cfg*/, topic_cb_t /*cb*/) { return EL_ENOTSUP; }
+
+el_err_code_t NetworkPosix::disconnect() { return EL_OK; }
+
+el_err_code_t NetworkPosix::subscribe(const char* /*topic*/, mqtt_qos_t /*qos*/) { return EL_ENOTSUP; }
+
+el_err_code_t NetworkPosix::unsubscribe(const char* /*topic*/) { return EL_ENOTSUP; }
+
+el_err_code_t NetworkPosix::publish(const char* /*topic*/,
+                                    const char* /*dat*/,
+                                    uint32_t /*len*/,
+                                    mqtt_qos_t /*qos*/) {
+    return EL_ENOTSUP;
+}
+
+}  // namespace edgelab
@@ -0,0 +1,190 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_serial_posix.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "el_device_posix.h"
+
+namespace edgelab {
+
+SerialPosix::SerialPosix(std::size_t rx_buffer_size)
+    : _send_lock(), _rx_fd(-1), _tx_fd(-1), _pty_fd(-1), _last('\0'), _size(rx_buffer_size), _rb_rx(nullptr) {}
+
+SerialPosix::~SerialPosix() { deinit(); }
+
+el_err_code_t SerialPosix::init() {
+    const char* mode = EL_POSIX_OPTION(CONFIG_EL_POSIX_SERIAL);
+
+    if (std::strcmp(mode, "pty") == 0) {
+        int master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) [[unlikely]] {
+            if (master >= 0) close(master);
+            return EL_EIO;
+        }
+
+        // the client gets the bytes as they are sent, without echo or line editing
+        const char* name = ptsname(master);
+        _pty_fd          = name ? open(name, O_RDWR | O_NOCTTY) : -1;
+        if (_pty_fd < 0) [[unlikely]] {
+            close(master);
+            return EL_EIO;
+        }
+        struct termios tio;
+        if (tcgetattr(_pty_fd, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(_pty_fd, TCSANOW, &tio);
+        }
+
+        _rx_fd = master;
+        _tx_fd = master;
+        EL_LOGI("[Serial] listening on %s", name);
+    } else {
+        _rx_fd = STDIN_FILENO;
+        _tx_fd = STDOUT_FILENO;
+    }
+
+    if (!this->_rb_rx) [[likely]]
+        this->_rb_rx = new lwRingBuffer{_size};
+
+    EL_ASSERT(this->_rb_rx);
+
+    this->_is_present = true;
+
+    return EL_OK;
+}
+
+el_err_code_t SerialPosix::deinit() {
+    if (_rx_fd >= 0 && _rx_fd != STDIN_FILENO) close(_rx_fd);
+    if (_pty_fd >= 0) close(_pty_fd);
+
+    _rx_fd  = -1;
+    _tx_fd  = -1;
+    _pty_fd = -1;
+
+    delete this->_rb_rx;
+    this->_rb_rx = nullptr;
+
+    this->_is_present = false;
+
+    return EL_OK;
+}
+
+// reads what arrives within timeout_ms (-1 blocks until something arrives), text line ends are normalized to a single
+// carriage return so terminals sending line feeds and clients sending both are understood alike
+std::size_t SerialPosix::read_available(char* buffer, size_t size, int timeout_ms, bool text) {
+    struct pollfd pfd {
+        .fd = _rx_fd, .events = POLLIN, .revents = 0
+    };
+    if (poll(&pfd, 1, timeout_ms) <= 0 || !(pfd.revents & POLLIN)) return 0;
+
+    ssize_t n = read(_rx_fd, buffer, size);
+    if (n <= 0) return 0;
+    if (!text) return n;
+
+    size_t kept = 0;
+    for (ssize_t i = 0; i < n; ++i) {
+        char c = buffer[i];
+        if (c == '\n') {
+            bool after_cr = _last == '\r';
+            _last         = c;
+            if (after_cr) continue;
+            c = '\r';
+        } else
+            _last = c;
+        buffer[kept++] = c;
+    }
+
+    return kept;
+}
+
+char SerialPosix::echo(bool only_visible) {
+    if (!this->_is_present) return '\0';
+
+    char c{get_char()};
+    if (only_visible && !std::isprint(c)) return c;
+    send_bytes(&c, sizeof(c));
+    return c;
+}
+
+char SerialPosix::get_char() {
+    if (!this->_is_present) return '\0';
+
+    char c{'\0'};
+    while (!read_available(&c, 1, -1, true))
+        ;
+    return c;
+}
+
+std::size_t SerialPosix::get_line(char* buffer, size_t size, const char delim) {
+    if (!this->_is_present) return 0;
+
+    size_t rlen = 0;
+    char   rbuf[32]{};  // most commands are less than 32 bytes long
+    do {
+        rlen = read_available(rbuf, EL_MIN(sizeof(rbuf), this->_rb_rx->free()), 1, true);
+        this->_rb_rx->put(rbuf, rlen);
+    } while (rlen > 0);
+
+    return this->_rb_rx->extract(delim, buffer, size);
+}
+
+std::size_t SerialPosix::read_bytes(char* buffer, size_t size) {
+    if (!this->_is_present) return 0;
+
+    size_t read{0};
+    while (read < size) read += read_available(buffer + read, size - read, -1, false);
+
+    return read;
+}
+
+std::size_t SerialPosix::send_bytes(const char* buffer, size_t size) {
+    if (!this->_is_present) return 0;
+
+    const Guard<Mutex> guard(_send_lock);
+
+    size_t sent{0};
+    while (sent < size) {
+        ssize_t n = write(_tx_fd, buffer + sent, size - sent);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            break;
+        }
+        sent += n;
+    }
+
+    return sent;
+}
+
+}  // namespace edgelab
@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_SERIAL_POSIX_H_
+#define _EL_SERIAL_POSIX_H_
+
+#include "core/synchronize/el_guard.hpp"
+#include "core/synchronize/el_mutex.hpp"
+#include "porting/el_serial.h"
+
+namespace edgelab {
+
+// the AT interface over the standard streams or over a pseudo terminal a client (e.g. a serial monitor) opens
+class SerialPosix final : public Serial {
+   public:
+    SerialPosix(std::size_t rx_buffer_size = 8192);
+    ~SerialPosix() override;
+
+    el_err_code_t init() override;
+    el_err_code_t deinit() override;
+
+    char        echo(bool only_visible = true) override;
+    char        get_char() override;
+    std::size_t get_line(char* buffer, size_t size, const char delim = 0x0d) override;
+
+    std::size_t read_bytes(char* buffer, size_t size) override;
+    std::size_t send_bytes(const char* buffer, size_t size) override;
+
+   private:
+    std::size_t read_available(char* buffer, size_t size, int timeout_ms, bool text);
+
+    Mutex _send_lock;
+
+    int  _rx_fd;
+    int  _tx_fd;
+    int  _pty_fd;  // slave side of the pseudo terminal, kept open so the master never reads a hang up
+    char _last;    // last byte received, line feeds after a carriage return are dropped
+
+    std::size_t   _size;
+    lwRingBuffer* _rb_rx;
+};
+
+}  // namespace edgelab
+
+#endif
@@ -346,6 +346,12 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
         if (static_resource->current_task_id.load(std::memory_order_seq_cst) != _task_id) [[unlikely]]
             return;
 
+#if CONFIG_SSCMA_INVOKE_PIPELINED
+        // stays sequential if the tensors cannot be staged
+        if (_times == 1 && _results_only && _n_times == static_cast<std::size_t>(-1)) [[unlikely]]
+            algorithm->set_pipelined(true);
+#endif
+
         auto camera = static_resource->device->get_camera();
         auto frame  = el_img_t{};
 #if CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC
@@ -2,6 +2,7 @@
 
 #include <string>
 
+#include "core/utils/el_heap.h"
 #include "sscma/definations.hpp"
 #include "sscma/static_resource.hpp"
 #include "sscma/utility.hpp"
@@ -25,20 +26,50 @@ void get_available_models(const std::string& cmd, void* caller) {
     static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
 }
 
+#if CONFIG_SSCMA_TENSOR_ARENA_AUTO_SIZE
+// keeps what the loaded models take plus the margin and lends the rest to el_malloc, returns the size kept
+size_t trim_tensor_arena(uint8_t* tensor_arena, size_t size) {
+    el_engine_memory_t memory{};
+    static_resource->engine->get_memory_usage(&memory);
+
+    size_t keep = (memory.used + CONFIG_SSCMA_TENSOR_ARENA_MARGIN + 31u) & ~static_cast<size_t>(31u);
+    if (keep >= size || static_resource->engine->init(tensor_arena, keep) != EL_OK) return size;
+    if (el_heap_lend(tensor_arena + keep, size - keep) != EL_OK) [[unlikely]] {
+        static_resource->engine->init(tensor_arena, size);
+        return size;
+    }
+
+    EL_LOGI("[SSCMA] tensor arena trimmed to %u bytes, %u bytes lent",
+            static_cast<unsigned>(keep),
+            static_cast<unsigned>(size - keep));
+    return keep;
+}
+#endif
+
 void set_model(const std::string& cmd, uint8_t model_id, void* caller, bool called_by_event = false) {
-    const auto& model_info = static_resource->models->get_model_info(model_id);
+    auto model_info = static_resource->models->get_model_info(model_id);
+
+    // the model index only knows the models found when it was made, one flashed since is looked for in the partition,
+    // once per id so asking for a missing model again does not walk the partition each time
+    static uint16_t sought_model_ids = 0u;  // as wide as the model id mask
+    if (!model_info.id && model_id && model_id < (sizeof(sought_model_ids) << 3u) &&
+        !(sought_model_ids & (1u << model_id))) [[unlikely]] {
+        sought_model_ids |= 1u << model_id;
+        static_resource->models->seek_models_from_flash(EL_MODEL_FMT_PACKED_TFLITE | EL_MODEL_FMT_PLAIN_TFLITE);
+        model_info = static_resource->models->get_model_info(model_id);
+    }
 
     // a valid model id should always > 0
     auto ret = model_info.id ? EL_OK : EL_EINVAL;
     if (ret != EL_OK) [[unlikely]]
         goto ModelReply;
 
-    // allocate tensor arena once (memset to 0 every time)
-    static auto* tensor_arena = el_aligned_malloc_once(32, CONFIG_SSCMA_TENSOR_ARENA_SIZE);
-    std::memset(tensor_arena, 0, CONFIG_SSCMA_TENSOR_ARENA_SIZE);
+    // allocate tensor arena once, the engine zeroes the part a newly loaded model is prepared in
+    static auto*  tensor_arena      = static_cast<uint8_t*>(el_aligned_malloc_once(32, CONFIG_SSCMA_TENSOR_ARENA_SIZE));
+    static size_t tensor_arena_size = CONFIG_SSCMA_TENSOR_ARENA_SIZE;
 
-    // init engine with tensor arena
-    ret = static_resource->engine->init(tensor_arena, CONFIG_SSCMA_TENSOR_ARENA_SIZE);
+    // init engine with tensor arena, models already prepared in it stay resident
+    ret = static_resource->engine->init(tensor_arena, tensor_arena_size);
     if (ret != EL_OK) [[unlikely]]
         goto ModelError;
 
@@ -47,6 +78,12 @@ void set_model(const std::string& cmd, uint8_t model_id, void* caller, bool call
     if (ret != EL_OK) [[unlikely]]
         goto ModelError;
 
+#if CONFIG_SSCMA_TENSOR_ARENA_AUTO_SIZE
+    // the first model loaded decides the size of the arena for good
+    if (tensor_arena_size == CONFIG_SSCMA_TENSOR_ARENA_SIZE)
+        tensor_arena_size = trim_tensor_arena(tensor_arena, tensor_arena_size);
+#endif
+
     // if model id changed, update current model id
     if (static_resource->current_model_id != model_id) {
         static_resource->current_model_id = model_id;
@@ -64,6 +101,9 @@ ModelError:
     static_resource->current_model_id = 0;
 
 ModelReply:
+    el_engine_memory_t memory{};
+    static_resource->engine->get_memory_usage(&memory);
+
     auto ss{concat_strings("\r{\"type\": ",
                            std::to_string(called_by_event ? 1 : 0),
                            ", \"name\": \"",
@@ -71,7 +111,7 @@ ModelReply:
                            "\", \"code\": ",
                            std::to_string(ret),
                            ", \"data\": {\"model\": ",
-                           model_info_2_json_str(model_info),
+                           model_info_2_json_str(model_info, &memory),
                            "}}\n")};
     static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
 }
@@ -79,12 +119,15 @@ ModelReply:
 void get_model_info(const std::string& cmd, void* caller) {
     const auto& model_info = static_resource->models->get_model_info(static_resource->current_model_id);
 
+    el_engine_memory_t memory{};
+    static_resource->engine->get_memory_usage(&memory);
+
     auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
                            cmd,
                            "\", \"code\": ",
                            std::to_string(EL_OK),
                            ", \"data\": ",
-                           model_info_2_json_str(model_info),
+                           model_info_2_json_str(model_info, &memory),
                            "}\n")};
     static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
 }
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "sscma/definations.hpp"
+#include "sscma/static_resource.hpp"
+#include "sscma/utility.hpp"
+
+namespace sscma::callback {
+
+using namespace edgelab;
+using namespace sscma::utility;
+
+void set_profiling(const std::string& cmd, bool enable, void* caller) {
+    auto ret = static_resource->engine->set_profiling(enable);
+
+    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
+                           cmd,
+                           "\", \"code\": ",
+                           std::to_string(ret),
+                           ", \"data\": ",
+                           std::to_string(ret == EL_OK ? enable : 0),
+                           "}\n")};
+    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+}
+
+void get_profile(const std::string& cmd, void* caller) {
+    el_engine_profile_t profile{};
+    auto                ret  = static_resource->engine->get_profile(&profile);
+    auto                data = engine_profile_2_json_str(profile);
+
+#ifdef CONFIG_EL_POSIX_PROFILE_FILE
+    // the host build also keeps the last report on disk for offline analysis
+    const char* path = std::getenv("CONFIG_EL_POSIX_PROFILE_FILE");
+    if (FILE* file = std::fopen(path ? path : CONFIG_EL_POSIX_PROFILE_FILE, "w")) {
+        std::fputs(data.c_str(), file);
+        std::fputc('\n', file);
+        std::fclose(file);
+    }
+#endif
+
+    auto ss{concat_strings(
+      "\r{\"type\": 0, \"name\": \"", cmd, "\", \"code\": ", std::to_string(ret), ", \"data\": ", data, "}\n")};
+    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+}
+
+}  // namespace sscma::callback
@@ -6,6 +6,22 @@
     #define CONFIG_SSCMA_TENSOR_ARENA_SIZE (1024U * 1024U)
 #endif
 
+#ifndef CONFIG_SSCMA_TENSOR_ARENA_AUTO_SIZE
+    // trims the tensor arena to the first model loaded plus the margin and lends the rest to el_malloc, models
+    // loaded later have to fit in what is kept
+    #define CONFIG_SSCMA_TENSOR_ARENA_AUTO_SIZE 0
+#endif
+
+#ifndef CONFIG_SSCMA_TENSOR_ARENA_MARGIN
+    #define CONFIG_SSCMA_TENSOR_ARENA_MARGIN (32U * 1024U)
+#endif
+
+#ifndef CONFIG_SSCMA_INVOKE_PIPELINED
+    // endless results only invokes preprocess the next frame while the engine still runs the current one, each
+    // reply then carries the results of the frame before, only worth it where the engine runs asynchronously
+    #define CONFIG_SSCMA_INVOKE_PIPELINED CONFIG_EL_ENGINE_ASYNC
+#endif
+
 #define SSCMA_EXECUTOR_WORKER_NAME_PREFIX "sscma#executor"
 
 #define SSCMA_REPL_EXECUTOR_STACK_SIZE    20480U
@@ -10,6 +10,7 @@
 #include "callback/invoke.hpp"
 #include "callback/model.hpp"
 #include "callback/mqtt.hpp"
+#include "callback/profile.hpp"
 #include "callback/sample.hpp"
 #include "callback/sensor.hpp"
 #include "callback/wifi.hpp"
@@ -145,6 +146,25 @@ void register_commands() {
           return EL_OK;
       });
 
+    static_resource->instance->register_cmd(
+      "PROFILE",
+      "Enable or disable per operator timing of the model",
+      "ENABLE/DISABLE",
+      [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), enable = std::atoi(argv[1].c_str()) != 0, caller](const std::atomic<bool>&) {
+                set_profiling(cmd, enable, caller);
+            });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "PROFILE?", "Get per operator timing of the model", "", [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), caller](const std::atomic<bool>&) { get_profile(cmd, caller); });
+          return EL_OK;
+      });
+
     static_resource->instance->register_cmd(
       "ALGOS?", "Get available algorithms", "", [](std::vector<std::string> argv, void* caller) {
           static_resource->executor->add_task(
@@ -33,22 +33,36 @@ class Executor {
 
         // prepare worker name (FreeRTOS task required), reserve 2 bytes for uint8_t hex string
         _worker_name.reserve(_worker_name.length() + (sizeof(uint8_t) << 1) + 1);
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
         EL_ASSERT(_worker_name.size() < configMAX_TASK_NAME_LEN);
+#endif
 
         // convert worker id to hex string
         _worker_name += hex_literals[worker_id >> 4];
         _worker_name += hex_literals[worker_id & 0x0f];
 
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
         [[maybe_unused]] auto ret =
           xTaskCreate(&Executor::c_run, _worker_name.c_str(), stack_size, this, priority, &_worker_handler);
         EL_ASSERT(ret == pdPASS);  // TODO: handle error
+#elif CONFIG_EL_HAS_PTHREAD_SUPPORT
+        // stack size and priority are sized for the RTOS targets, a host thread keeps the system defaults
+        (void)stack_size;
+        (void)priority;
+        [[maybe_unused]] auto ret = pthread_create(&_worker_handler, nullptr, &Executor::p_run, this);
+        EL_ASSERT(ret == 0);  // TODO: handle error
+#endif
     }
 
     ~Executor() {
         _task_stop_requested.store(true, std::memory_order_seq_cst);
         _worker_thread_stop_requested.store(true, std::memory_order_seq_cst);
         while (_worker_thread_stop_requested.load()) yield();  // wait for destory
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
         vTaskDelete(_worker_handler);
+#elif CONFIG_EL_HAS_PTHREAD_SUPPORT
+        pthread_join(_worker_handler, nullptr);
+#endif
     }
 
     // the Callable must be a function object or a lambda, the prototype is repl_task_t
@@ -70,7 +84,11 @@ class Executor {
     }
 
    protected:
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
     inline void yield() const { vTaskDelay(10 / portTICK_PERIOD_MS); }
+#else
+    inline void yield() const { el_sleep(10); }
+#endif
 
     void run() {
         while (!_worker_thread_stop_requested.load()) {
@@ -96,13 +114,24 @@ class Executor {
 
     static void c_run(void* this_pointer) { static_cast<Executor*>(this_pointer)->run(); }
 
+#if CONFIG_EL_HAS_PTHREAD_SUPPORT
+    static void* p_run(void* this_pointer) {
+        c_run(this_pointer);
+        return nullptr;
+    }
+#endif
+
    private:
     Mutex             _task_queue_lock;
     std::atomic<bool> _task_stop_requested;
     std::atomic<bool> _worker_thread_stop_requested;
 
     std::string  _worker_name;
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
     TaskHandle_t _worker_handler;
+#elif CONFIG_EL_HAS_PTHREAD_SUPPORT
+    pthread_t _worker_handler;
+#endif
 
     std::queue<repl_task_t> _task_queue;
 };
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <list>
 
+#include "core/el_debug.h"
 #include "core/synchronize/el_guard.hpp"
 #include "core/synchronize/el_mutex.hpp"
 #include "porting/el_misc.h"
@@ -63,6 +64,7 @@ class Supervisor {
 
    protected:
     Supervisor() noexcept {
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
         [[maybe_unused]] auto ret = xTaskCreate(&Supervisor::c_run,
                                                 SSCMA_REPL_SUPERVISOR_NAME,
                                                 SSCMA_REPL_SUPERVISOR_STACK_SIZE,
@@ -70,6 +72,12 @@ class Supervisor {
                                                 SSCMA_REPL_SUPERVISOR_PRIO,
                                                 nullptr);
         EL_ASSERT(ret == pdPASS);  // TODO: handle error
+#elif CONFIG_EL_HAS_PTHREAD_SUPPORT
+        pthread_t             thread;
+        [[maybe_unused]] auto ret = pthread_create(&thread, nullptr, &Supervisor::p_run, this);
+        EL_ASSERT(ret == 0);  // TODO: handle error
+        pthread_detach(thread);
+#endif
     }
 
     void run() {
@@ -84,6 +92,13 @@ class Supervisor {
 
     static void c_run(void* this_pointer) { static_cast<Supervisor*>(this_pointer)->run(); }
 
+#if CONFIG_EL_HAS_PTHREAD_SUPPORT
+    static void* p_run(void* this_pointer) {
+        c_run(this_pointer);
+        return nullptr;
+    }
+#endif
+
    private:
     std::list<SupervisedObject> _supervised_objects;
     Mutex                       _supervised_objects_lock;
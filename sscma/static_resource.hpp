@@ -138,8 +138,9 @@ class StaticResource final {
 
     inline void init_backend() {
         EL_LOGI("[SSCMA] loading resources from flash...");
-        models->init();
+        // the models are looked up in the index kept in storage first
         storage->init();
+        models->init();
 
         char version[EL_VERSION_LENTH_MAX]{};
         auto kv = el_make_storage_kv(SSCMA_STORAGE_KEY_VERSION, version);
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <forward_list>
 #include <memory>
@@ -60,17 +62,38 @@ inline static uint32_t color_literal(uint8_t i) {
     return color[i % 5];
 }
 
+// target id and score above the top left corner of the box, inside the box if there is no room above
+inline static void draw_box_label(el_img_t* img, int16_t x, int16_t y, uint16_t target, uint8_t score, uint32_t color) {
+    char label[16];
+    std::snprintf(label, sizeof(label), "%u: %u", target, score);
+    el_draw_text(img, x, y >= 9 ? y - 9 : y + 5, label, color);
+}
+
 void draw_results_on_image(const std::forward_list<el_point_t>& results, el_img_t* img) {
     uint8_t i = 0;
-    for (const auto& point : results) el_draw_point(img, point.x, point.y, color_literal(++i));
+    for (const auto& point : results) el_fill_circle(img, point.x, point.y, 3, color_literal(++i));
 }
 
 void draw_results_on_image(const std::forward_list<el_box_t>& results, el_img_t* img) {
     uint8_t i = 0;
     for (const auto& box : results) {
-        int16_t y = box.y - (box.h >> 1);  // center y
-        int16_t x = box.x - (box.w >> 1);  // center x
-        el_draw_rect(img, x, y, box.w, box.h, color_literal(++i), 4);
+        int16_t  y     = box.y - (box.h >> 1);  // center y
+        int16_t  x     = box.x - (box.w >> 1);  // center x
+        uint32_t color = color_literal(++i);
+        el_draw_rect(img, x, y, box.w, box.h, color, 4);
+        draw_box_label(img, x, y, box.target, box.score, color);
+    }
+}
+
+void draw_results_on_image(const std::forward_list<el_keypoint_t>& results, el_img_t* img) {
+    uint8_t i = 0;
+    for (const auto& kp : results) {
+        int16_t  y     = kp.box.y - (kp.box.h >> 1);  // center y
+        int16_t  x     = kp.box.x - (kp.box.w >> 1);  // center x
+        uint32_t color = color_literal(++i);
+        el_draw_rect(img, x, y, kp.box.w, kp.box.h, color, 2);
+        draw_box_label(img, x, y, kp.box.target, kp.box.score, color);
+        for (const auto& pt : kp.pts) el_fill_circle(img, pt.x, pt.y, 2, color);
     }
 }
 
@@ -103,7 +126,20 @@ template <typename T> decltype(auto) to_hex_string(T dec) {
     return hex;
 }
 
-decltype(auto) model_info_2_json_str(const el_model_info_t& model_info) {
+decltype(auto) engine_memory_2_json_str(const el_engine_memory_t& memory) {
+    return concat_strings("{\"size\": ",
+                          std::to_string(memory.size),
+                          ", \"used\": ",
+                          std::to_string(memory.used),
+                          ", \"model\": ",
+                          std::to_string(memory.model),
+                          ", \"peak\": ",
+                          std::to_string(memory.peak),
+                          "}");
+}
+
+// the tensor arena usage is only known for the model loaded in the engine
+decltype(auto) model_info_2_json_str(const el_model_info_t& model_info, const el_engine_memory_t* memory = nullptr) {
     return concat_strings("{\"id\": ",
                           std::to_string(model_info.id),
                           ", \"type\": ",
@@ -112,6 +148,7 @@ decltype(auto) model_info_2_json_str(const el_model_info_t& model_info) {
                           std::to_string(model_info.addr_flash),
                           ", \"size\": ",
                           std::to_string(model_info.size),
+                          memory ? concat_strings(", \"arena\": ", engine_memory_2_json_str(*memory)) : std::string(),
                           "}");
 }
 
@@ -264,34 +301,57 @@ inline decltype(auto) img_2_json_str(const el_img_t* img) {
     return concat_strings("\"image\": \"", buffer, "\"");
 }
 
-// TODO: avoid repeatly allocate/release memory in for loop
 inline decltype(auto) img_2_jpeg_json_str(const el_img_t* img) {
     if (!img || !img->data || !img->size) [[unlikely]]
         return std::string("\"image\": \"\"");
 
-    static std::size_t size      = 0;
-    static uint8_t*    jpeg_data = nullptr;
-    std::size_t        jpeg_size = img->size >> 2u;  // assuing jpeg size is 1/4 of raw image size
-    // only reallcate memory when buffer size is not enough (TODO: reallocate logging for profiling)
-    if (jpeg_size > size) [[unlikely]] {
-        size = jpeg_size;
-        if (jpeg_data) [[likely]]
-            delete[] jpeg_data;
-        jpeg_data = new uint8_t[size]{};
-    }
+    // previews are subsampled 4:2:0, it roughly halves both the encoding time and the payload
+    static constexpr el_jpeg_config_t config{.quality = EL_JPEG_QUALITY_LOW, .subsample = EL_JPEG_SUBSAMPLE_420};
+
+    // the compressed chunks are base64 encoded as the encoder emits them, bytes that do not fill a whole base64
+    // quantum are carried over to the next chunk
+    struct base64_sink_t {
+        std::string str;
+        uint8_t     carry[3];
+        std::size_t carried;
+    } sink{.str = std::string("\"image\": \""), .carry = {}, .carried = 0};
+
+    auto write = [](const uint8_t* data, std::size_t size, void* user) -> el_err_code_t {
+        auto* sink = static_cast<base64_sink_t*>(user);
+        auto  put  = [sink](const uint8_t* in, std::size_t len) {
+            auto pos = sink->str.size();
+            sink->str.resize(pos + ((len + 2u) / 3u << 2u));
+            el_base64_encode(in, static_cast<int>(len), &sink->str[pos]);
+        };
+
+        if (sink->carried) {
+            while (sink->carried < 3u && size) {
+                sink->carry[sink->carried++] = *data++;
+                --size;
+            }
+            if (sink->carried < 3u) return EL_OK;
+            put(sink->carry, 3u);
+            sink->carried = 0;
+        }
+
+        auto whole = size - size % 3u;
+        if (whole) put(data, whole);
+        while (whole < size) sink->carry[sink->carried++] = data[whole++];
+
+        return EL_OK;
+    };
 
-    std::memset(jpeg_data, 0, size);
-    auto jpeg_img = el_img_t{.data   = jpeg_data,
-                             .size   = size,
-                             .width  = img->width,
-                             .height = img->height,
-                             .format = EL_PIXEL_FORMAT_JPEG,
-                             .rotate = img->rotate};
+    if (el_img_encode_jpeg(img, &config, write, &sink) != EL_OK) [[unlikely]]
+        return std::string("\"image\": \"\"");
 
-    if (el_img_convert(img, &jpeg_img) == EL_OK) [[likely]]
-        return img_2_json_str(&jpeg_img);
+    if (sink.carried) {
+        auto pos = sink.str.size();
+        sink.str.resize(pos + 4u);
+        el_base64_encode(sink.carry, static_cast<int>(sink.carried), &sink.str[pos]);
+    }
+    sink.str += '"';
 
-    return std::string("\"image\": \"\"");
+    return std::string(std::move(sink.str));
 }
 
 decltype(auto) algorithm_info_2_json_str(const el_algorithm_info_t* info) {
@@ -346,6 +406,60 @@ decltype(auto) algorithm_results_2_json_str(std::shared_ptr<AlgorithmType> algor
     return ss;
 }
 
+// per node timings followed by their sums per operator type, slowest type first, averages are per invocation
+decltype(auto) engine_profile_2_json_str(const el_engine_profile_t& profile) {
+    struct op_sum_t {
+        const char* tag;
+        uint32_t    nodes;
+        uint64_t    total_us;
+    };
+    std::vector<op_sum_t> ops;
+    uint64_t              total_us    = 0;
+    uint32_t              invocations = profile.invocations ? profile.invocations : 1;
+
+    std::string ss{concat_strings("{\"invocations\": ", std::to_string(profile.invocations), ", \"nodes\": [")};
+    for (size_t i = 0; i < profile.size; ++i) {
+        const auto& node = profile.nodes[i];
+        const char* tag  = node.tag ? node.tag : "UNKNOWN";
+        if (i) ss += ", ";
+        ss += concat_strings("{\"index\": ",
+                             std::to_string(i),
+                             ", \"op\": ",
+                             quoted(tag),
+                             ", \"count\": ",
+                             std::to_string(node.count),
+                             ", \"avg_us\": ",
+                             std::to_string(node.count ? node.total_us / node.count : 0),
+                             ", \"max_us\": ",
+                             std::to_string(node.max_us),
+                             "}");
+
+        auto it = std::find_if(ops.begin(), ops.end(), [tag](const op_sum_t& op) { return !std::strcmp(op.tag, tag); });
+        if (it == ops.end()) it = ops.insert(ops.end(), {tag, 0, 0});
+        it->nodes += 1;
+        it->total_us += node.total_us;
+        total_us += node.total_us;
+    }
+
+    std::sort(ops.begin(), ops.end(), [](const op_sum_t& l, const op_sum_t& r) { return l.total_us > r.total_us; });
+    ss += concat_strings("], \"total_us\": ", std::to_string(total_us / invocations), ", \"ops\": [");
+    for (size_t i = 0; i < ops.size(); ++i) {
+        if (i) ss += ", ";
+        ss += concat_strings("{\"op\": ",
+                             quoted(ops[i].tag),
+                             ", \"nodes\": ",
+                             std::to_string(ops[i].nodes),
+                             ", \"avg_us\": ",
+                             std::to_string(ops[i].total_us / invocations),
+                             ", \"percent\": ",
+                             std::to_string(total_us ? ops[i].total_us * 100 / total_us : 0),
+                             "}");
+    }
+    ss += "]}";
+
+    return ss;
+}
+
 decltype(auto) wifi_config_2_json_str(const wifi_sta_cfg_t& config, bool secure = true) {
     auto        pwd = /* secure ? std::string(std::strlen(config.passwd), '*') : */ std::string(config.passwd);
     std::string ss{concat_strings("{\"name_type\": ",
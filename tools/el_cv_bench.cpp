@@ -0,0 +1,139 @@
+// Runs the el_cv_bench conversion and jpeg encoder benchmark on the host and writes one json line per case, to be
+// compared across builds or against a device run. Built against a port config (e.g. porting/posix with
+// -DCONFIG_EL_TARGET_POSIX) together with core/utils/el_cv.cpp, el_cv_bench.cpp and el_jpeg.cpp, the port's el_misc
+// and third_party/JPEGENC. Masks are bit masks of the el_pixel_* enumerators and take 0x prefixed hex, 0 or a missing
+// option selects every case.
+//
+//   el_cv_bench -s 320x240 -f 0x2 -d 0x9 -r 0x1 -i 0x3 -k 1,0.5 -t 100 > bench.jsonl
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "core/utils/el_cv_bench.h"
+
+namespace {
+
+void usage(const char* name) {
+    std::fprintf(stderr,
+                 "usage: %s [-s WIDTHxHEIGHT] [-f SRC_FORMATS] [-d DST_FORMATS] [-r ROTATES] [-i INTERPS]\n"
+                 "          [-k RATIO[,RATIO...]] [-t MIN_TIME_MS] [-o FILE]\n",
+                 name);
+}
+
+bool parse_uint(const char* str, unsigned long max, unsigned long* value) {
+    char* end = nullptr;
+    *value    = std::strtoul(str, &end, 0);
+    return end != str && *end == '\0' && *value <= max;
+}
+
+bool parse_size(const char* str, uint16_t* width, uint16_t* height) {
+    char*         end = nullptr;
+    unsigned long w   = std::strtoul(str, &end, 10);
+    if (end == str || *end != 'x') return false;
+    const char*   h_str = end + 1;
+    unsigned long h     = std::strtoul(h_str, &end, 10);
+    if (end == h_str || *end != '\0' || !w || !h || w > UINT16_MAX || h > UINT16_MAX) return false;
+    *width  = static_cast<uint16_t>(w);
+    *height = static_cast<uint16_t>(h);
+    return true;
+}
+
+bool parse_ratios(const char* str, std::vector<float>* ratios) {
+    for (const char* it = str;;) {
+        char* end   = nullptr;
+        float ratio = std::strtof(it, &end);
+        if (end == it || ratio <= 0.f || ratios->size() >= UINT8_MAX) return false;
+        ratios->push_back(ratio);
+        if (*end == '\0') return true;
+        if (*end != ',') return false;
+        it = end + 1;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    edgelab::el_cv_bench_config_t config{};
+    std::vector<float>            ratios;
+    const char*                   path = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strlen(argv[i]) != 2 || argv[i][0] != '-' || i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        const char*   arg   = argv[++i];
+        unsigned long value = 0;
+        bool          ok    = true;
+        switch (argv[i - 1][1]) {
+        case 's':
+            ok = parse_size(arg, &config.width, &config.height);
+            break;
+        case 'f':
+            ok                 = parse_uint(arg, UINT32_MAX, &value);
+            config.src_formats = static_cast<uint32_t>(value);
+            break;
+        case 'd':
+            ok                 = parse_uint(arg, UINT32_MAX, &value);
+            config.dst_formats = static_cast<uint32_t>(value);
+            break;
+        case 'r':
+            ok             = parse_uint(arg, UINT8_MAX, &value);
+            config.rotates = static_cast<uint8_t>(value);
+            break;
+        case 'i':
+            ok             = parse_uint(arg, UINT8_MAX, &value);
+            config.interps = static_cast<uint8_t>(value);
+            break;
+        case 'k':
+            ratios.clear();
+            ok = parse_ratios(arg, &ratios);
+            break;
+        case 't':
+            ok                 = parse_uint(arg, UINT32_MAX, &value);
+            config.min_time_ms = static_cast<uint32_t>(value);
+            break;
+        case 'o':
+            path = arg;
+            break;
+        default:
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "%s: bad value %s for %s\n", argv[0], arg, argv[i - 1]);
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    config.ratios      = ratios.empty() ? nullptr : ratios.data();
+    config.ratio_count = static_cast<uint8_t>(ratios.size());
+
+    FILE* file = path ? std::fopen(path, "w") : stdout;
+    if (!file) {
+        std::fprintf(stderr, "%s: cannot open %s\n", argv[0], path);
+        return 1;
+    }
+
+    auto ret = edgelab::el_cv_bench(
+      &config,
+      [](const edgelab::el_cv_bench_result_t* result, void* user) {
+          char line[512];
+          int  len = edgelab::el_cv_bench_to_json(result, line, sizeof(line));
+          if (len < 0 || static_cast<size_t>(len) >= sizeof(line)) return EL_EIO;
+          auto* file = static_cast<FILE*>(user);
+          if (std::fputs(line, file) < 0 || std::fputc('\n', file) < 0) return EL_EIO;
+          return EL_OK;
+      },
+      file);
+
+    if (path) std::fclose(file);
+    if (ret != EL_OK) {
+        std::fprintf(stderr, "%s: benchmark stopped with error %d\n", argv[0], static_cast<int>(ret));
+        return 1;
+    }
+
+    return 0;
+}
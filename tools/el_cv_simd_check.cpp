@@ -0,0 +1,219 @@
+// Checks the vectorized span converters of core/utils/el_cv.cpp bit for bit against the scalar converters they
+// replace, on random images of odd widths and of multiples of the vector widths, then the scalar converters against
+// the conversion plan at nearest sampling, scaled and rotated by 0 and 180 degrees, and exits non-zero on the first
+// differing byte. The kernels are local to el_cv.cpp, so that file is included here and not linked. Built against a
+// port config (e.g. porting/posix with -DCONFIG_EL_TARGET_POSIX) together with the port's el_misc and
+// third_party/JPEGENC, once per compiler and target the converters are built for.
+//
+//   el_cv_simd_check [SEED]
+
+#include "core/utils/el_cv.cpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#if !CONFIG_EL_CV_SIMD
+    #error "the vectorized converters are disabled, CONFIG_EL_CV_SIMD is 0 for this target"
+#endif
+
+namespace {
+
+using namespace edgelab;
+
+struct check_case_t {
+    const char*       name;
+    el_pixel_format_t src_format;
+    el_pixel_format_t dst_format;
+    bool              vectorized;  // simd::select has a span kernel for the pair
+    void (*scalar)(const el_img_t* src, el_img_t* dst);
+};
+
+const check_case_t CASES[] = {
+  {"rgb565_to_rgb888",
+   EL_PIXEL_FORMAT_RGB565,
+   EL_PIXEL_FORMAT_RGB888,
+   true,
+   [](const el_img_t* src, el_img_t* dst) { rgb565_to_rgb888(src, dst, &IDENTITY_LOOKUP_TABLE); }},
+  {"rgb565_to_gray",
+   EL_PIXEL_FORMAT_RGB565,
+   EL_PIXEL_FORMAT_GRAYSCALE,
+   true,
+   [](const el_img_t* src, el_img_t* dst) { rgb565_to_gray(src, dst, &IDENTITY_LOOKUP_TABLE); }},
+  {"rgb888_to_gray",
+   EL_PIXEL_FORMAT_RGB888,
+   EL_PIXEL_FORMAT_GRAYSCALE,
+   true,
+   [](const el_img_t* src, el_img_t* dst) { rgb888_to_gray(src, dst, &IDENTITY_LOOKUP_TABLE); }},
+  {"gray_to_rgb888",
+   EL_PIXEL_FORMAT_GRAYSCALE,
+   EL_PIXEL_FORMAT_RGB888,
+   true,
+   [](const el_img_t* src, el_img_t* dst) { gray_to_rgb888(src, dst, &IDENTITY_LOOKUP_TABLE); }},
+  {"gray_to_rgb565",
+   EL_PIXEL_FORMAT_GRAYSCALE,
+   EL_PIXEL_FORMAT_RGB565,
+   true,
+   [](const el_img_t* src, el_img_t* dst) { gray_to_rgb565(src, dst); }},
+  {"rgb888_to_rgb888",
+   EL_PIXEL_FORMAT_RGB888,
+   EL_PIXEL_FORMAT_RGB888,
+   true,
+   [](const el_img_t* src, el_img_t* dst) { rgb888_to_rgb888(src, dst, &IDENTITY_LOOKUP_TABLE); }},
+  {"rgb565_to_rgb565",
+   EL_PIXEL_FORMAT_RGB565,
+   EL_PIXEL_FORMAT_RGB565,
+   true,
+   [](const el_img_t* src, el_img_t* dst) { rgb565_to_rgb565(src, dst); }},
+  {"rgb888_to_rgb565",
+   EL_PIXEL_FORMAT_RGB888,
+   EL_PIXEL_FORMAT_RGB565,
+   false,
+   [](const el_img_t* src, el_img_t* dst) { rgb888_to_rgb565(src, dst); }},
+  {"gray_to_gray",
+   EL_PIXEL_FORMAT_GRAYSCALE,
+   EL_PIXEL_FORMAT_GRAYSCALE,
+   true,
+   [](const el_img_t* src, el_img_t* dst) { gray_to_gray(src, dst, &IDENTITY_LOOKUP_TABLE); }},
+};
+
+// every remainder of the 8 and 16 pixel vectors, whole vectors only and a frame wide row
+const uint16_t WIDTHS[]  = {
+  1, 2, 3, 5, 7, 8, 9, 15, 16, 17, 23, 24, 31, 32, 33, 47, 48, 63, 64, 65, 127, 128, 640, 641};
+const uint16_t HEIGHTS[] = {1, 2, 3, 8};
+
+// source and destination sizes of the plan comparison, unscaled, downscaled, upscaled and either way on each side
+const uint16_t PLAN_SIZES[][4] = {
+  {33, 17, 33, 17}, {64, 48, 32, 24}, {31, 9, 64, 20}, {160, 120, 96, 96}, {7, 5, 13, 3}};
+const el_pixel_rotate_t PLAN_ROTATES[] = {EL_PIXEL_ROTATE_0, EL_PIXEL_ROTATE_180};
+
+int report(const char*   name,
+           const char*   what,
+           unsigned      w,
+           unsigned      h,
+           unsigned long seed,
+           size_t        offset,
+           size_t        bpp,
+           uint8_t       got,
+           uint8_t       want) {
+    std::printf("%s %s %ux%u seed 0x%lX: byte %zu (pixel %zu) is 0x%02X, the scalar converter wrote 0x%02X\n",
+                name,
+                what,
+                w,
+                h,
+                seed,
+                offset,
+                offset / bpp,
+                got,
+                want);
+    std::fflush(stdout);
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    unsigned long                      seed = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 0x5EEDu;
+    std::mt19937                       rng(static_cast<std::mt19937::result_type>(seed));
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    size_t checked = 0;
+    for (const auto& c : CASES) {
+        if (!c.vectorized) continue;
+        auto span_fn = simd::select(c.src_format, c.dst_format);
+        if (!span_fn) {
+            std::fprintf(stderr, "%s: no vectorized kernel\n", c.name);
+            return 1;
+        }
+
+        for (auto width : WIDTHS)
+            for (auto height : HEIGHTS) {
+                size_t pixels = static_cast<size_t>(width) * height;
+
+                // odd sizes start one byte in, the kernels must not depend on the alignment of either buffer
+                size_t               align = width & 1u;
+                std::vector<uint8_t> src_buf(pixels * el_img_bpp(c.src_format) + align);
+                std::vector<uint8_t> simd_buf(pixels * el_img_bpp(c.dst_format) + align);
+                std::vector<uint8_t> scalar_buf(simd_buf.size());
+                for (auto& b : src_buf) b = static_cast<uint8_t>(byte(rng));
+                // differing fill patterns catch bytes either side leaves unwritten
+                std::fill(simd_buf.begin(), simd_buf.end(), 0xA5);
+                std::fill(scalar_buf.begin(), scalar_buf.end(), 0x5A);
+
+                el_img_t src{};
+                src.data   = src_buf.data() + align;
+                src.size   = src_buf.size() - align;
+                src.width  = width;
+                src.height = height;
+                src.format = c.src_format;
+                src.rotate = EL_PIXEL_ROTATE_0;
+
+                el_img_t dst{};
+                dst.data   = scalar_buf.data() + align;
+                dst.size   = scalar_buf.size() - align;
+                dst.width  = width;
+                dst.height = height;
+                dst.format = c.dst_format;
+                dst.rotate = EL_PIXEL_ROTATE_0;
+
+                c.scalar(&src, &dst);
+                span_fn(src.data, simd_buf.data() + align, pixels);
+
+                for (size_t i = align; i < simd_buf.size(); ++i)
+                    if (simd_buf[i] != scalar_buf[i])
+                        return report(c.name,
+                                      "span",
+                                      width,
+                                      height,
+                                      seed,
+                                      i - align,
+                                      el_img_bpp(c.dst_format),
+                                      simd_buf[i],
+                                      scalar_buf[i]);
+                ++checked;
+            }
+    }
+
+    size_t planned = 0;
+    for (const auto& c : CASES)
+        for (const auto& size : PLAN_SIZES)
+            for (auto rotate : PLAN_ROTATES) {
+                std::vector<uint8_t> src_buf(static_cast<size_t>(size[0]) * size[1] * el_img_bpp(c.src_format));
+                std::vector<uint8_t> plan_buf(static_cast<size_t>(size[2]) * size[3] * el_img_bpp(c.dst_format), 0xA5);
+                std::vector<uint8_t> scalar_buf(plan_buf.size(), 0x5A);
+                for (auto& b : src_buf) b = static_cast<uint8_t>(byte(rng));
+
+                el_img_t src{src_buf.data(), src_buf.size(), size[0], size[1], c.src_format, EL_PIXEL_ROTATE_0, 0};
+                el_img_t dst{scalar_buf.data(), scalar_buf.size(), size[2], size[3], c.dst_format, rotate, 0};
+                c.scalar(&src, &dst);
+
+                ImgConvertPlan plan;
+                dst.data = plan_buf.data();
+                auto ret = plan.build(&src, &dst);
+                if (ret == EL_OK) ret = plan.execute(&src, &dst);
+                if (ret != EL_OK) {
+                    std::printf("%s plan %ux%u: returned %d\n", c.name, size[2], size[3], static_cast<int>(ret));
+                    return 1;
+                }
+
+                for (size_t i = 0; i < plan_buf.size(); ++i)
+                    if (plan_buf[i] != scalar_buf[i])
+                        return report(c.name,
+                                      rotate == EL_PIXEL_ROTATE_0 ? "plan" : "plan at 180",
+                                      size[2],
+                                      size[3],
+                                      seed,
+                                      i,
+                                      el_img_bpp(c.dst_format),
+                                      plan_buf[i],
+                                      scalar_buf[i]);
+                ++planned;
+            }
+
+    std::printf("%zu images bit exact over the vectorized and %zu over the planned converters\n", checked, planned);
+    return 0;
+}
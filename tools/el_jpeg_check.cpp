@@ -0,0 +1,166 @@
+// Checks the baseline jpeg decoder of core/utils/el_jpeg.cpp on streams made by the encoder and on malformed ones,
+// exits non-zero on the first case that decodes wrongly or is not turned away. Meant to be built with
+// -fsanitize=address,undefined so a malformed stream reading or writing out of bounds is caught where it happens.
+// Built against a port config (e.g. porting/posix with -DCONFIG_EL_TARGET_POSIX) together with core/utils/el_cv.cpp
+// and el_jpeg.cpp, the port's el_misc and third_party/JPEGENC.
+//
+//   el_jpeg_check
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "core/el_common.h"
+#include "core/utils/el_cv.h"
+#include "core/utils/el_jpeg.h"
+
+namespace {
+
+using namespace edgelab;
+
+constexpr uint16_t WIDTH  = 64;
+constexpr uint16_t HEIGHT = 48;
+
+std::vector<uint8_t> encode(el_pixel_format_t format) {
+    uint8_t              bpp = el_img_bpp(format);
+    std::vector<uint8_t> pixels(static_cast<size_t>(WIDTH) * HEIGHT * bpp);
+    // smooth gradients, a lossy round trip stays close to them
+    for (uint16_t y = 0; y < HEIGHT; ++y)
+        for (uint16_t x = 0; x < WIDTH; ++x)
+            for (uint8_t c = 0; c < bpp; ++c)
+                pixels[(static_cast<size_t>(y) * WIDTH + x) * bpp + c] = static_cast<uint8_t>(x * 3 + y * 2 + c * 40);
+
+    el_img_t src{};
+    src.data   = pixels.data();
+    src.size   = pixels.size();
+    src.width  = WIDTH;
+    src.height = HEIGHT;
+    src.format = format;
+    src.rotate = EL_PIXEL_ROTATE_0;
+
+    std::vector<uint8_t> jpeg;
+    el_jpeg_config_t     config{EL_JPEG_QUALITY_BEST, EL_JPEG_SUBSAMPLE_444};
+    auto                 ret = el_img_encode_jpeg(
+      &src,
+      &config,
+      [](const uint8_t* data, size_t size, void* user) {
+          static_cast<std::vector<uint8_t>*>(user)->insert(static_cast<std::vector<uint8_t>*>(user)->end(),
+                                                           data,
+                                                           data + size);
+          return EL_OK;
+      },
+      &jpeg);
+    if (ret != EL_OK) jpeg.clear();
+    return jpeg;
+}
+
+el_err_code_t decode(const std::vector<uint8_t>& jpeg, el_pixel_format_t format, uint8_t scale, uint32_t* error) {
+    uint16_t             w = (WIDTH + scale - 1) / scale;
+    uint16_t             h = (HEIGHT + scale - 1) / scale;
+    std::vector<uint8_t> pixels(static_cast<size_t>(w) * h * el_img_bpp(format));
+
+    el_img_t dst{};
+    dst.data   = pixels.data();
+    dst.size   = pixels.size();
+    dst.width  = w;
+    dst.height = h;
+    dst.format = format;
+    dst.rotate = EL_PIXEL_ROTATE_0;
+
+    auto ret = el_jpeg_decode(jpeg.data(), jpeg.size(), scale, &dst);
+    if (ret != EL_OK || !error) return ret;
+
+    // mean absolute error against the gradient at the centre of each box
+    uint64_t sum = 0;
+    uint8_t  bpp = el_img_bpp(format);
+    for (uint16_t y = 0; y < h; ++y)
+        for (uint16_t x = 0; x < w; ++x)
+            for (uint8_t c = 0; c < bpp; ++c) {
+                uint32_t sx  = EL_MIN(static_cast<uint32_t>(x * scale + scale / 2), WIDTH - 1u);
+                uint32_t sy  = EL_MIN(static_cast<uint32_t>(y * scale + scale / 2), HEIGHT - 1u);
+                int32_t  ref = static_cast<uint8_t>(sx * 3 + sy * 2 + c * 40);
+                int32_t  got = pixels[(static_cast<size_t>(y) * w + x) * bpp + c];
+                sum += static_cast<uint32_t>(got > ref ? got - ref : ref - got);
+            }
+    *error = static_cast<uint32_t>(sum / pixels.size());
+    return EL_OK;
+}
+
+// a DHT segment right after SOI, counts[l - 1] codes of each length with as many symbols
+std::vector<uint8_t> with_dht(const std::vector<uint8_t>& jpeg, const uint8_t (&counts)[16]) {
+    size_t total = 0;
+    for (auto n : counts) total += n;
+    size_t len = 2 + 17 + total;
+
+    std::vector<uint8_t> seg{0xFF, 0xC4, static_cast<uint8_t>(len >> 8), static_cast<uint8_t>(len), 0x00};
+    seg.insert(seg.end(), counts, counts + 16);
+    for (size_t i = 0; i < total; ++i) seg.push_back(static_cast<uint8_t>(i));
+
+    std::vector<uint8_t> out(jpeg.begin(), jpeg.begin() + 2);
+    out.insert(out.end(), seg.begin(), seg.end());
+    out.insert(out.end(), jpeg.begin() + 2, jpeg.end());
+    return out;
+}
+
+bool fail(const char* what, el_err_code_t ret) {
+    std::printf("%s: returned %d\n", what, static_cast<int>(ret));
+    std::fflush(stdout);
+    return false;
+}
+
+bool check_round_trip(el_pixel_format_t format, const char* name) {
+    auto jpeg = encode(format);
+    if (jpeg.empty()) return fail(name, EL_EIO);
+
+    for (uint8_t scale : {1, 2, 4, 8}) {
+        uint32_t error = 0;
+        auto     ret   = decode(jpeg, format, scale, &error);
+        if (ret != EL_OK) return fail(name, ret);
+        // the idct downscale averages a box, the gradient step across one is the bound
+        if (error > 4u + scale * 3u) {
+            std::printf(
+              "%s at 1/%u: mean error %u\n", name, static_cast<unsigned>(scale), static_cast<unsigned>(error));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool check_rejected(const char* name, const std::vector<uint8_t>& jpeg) {
+    auto ret = decode(jpeg, EL_PIXEL_FORMAT_RGB888, 1, nullptr);
+    return ret == EL_OK ? fail(name, ret) : true;
+}
+
+}  // namespace
+
+int main() {
+    if (!check_round_trip(EL_PIXEL_FORMAT_RGB888, "rgb888 round trip") ||
+        !check_round_trip(EL_PIXEL_FORMAT_GRAYSCALE, "grayscale round trip"))
+        return 1;
+
+    auto jpeg = encode(EL_PIXEL_FORMAT_RGB888);
+
+    // more codes of one length than the length can tell apart, short ones are spread into the lut
+    const uint8_t one_bit[16]     = {200};
+    const uint8_t two_bit[16]     = {1, 3};
+    const uint8_t three_bit[16]   = {0, 4, 1};
+    const uint8_t sixteen_bit[16] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3};
+
+    std::vector<uint8_t> headers_only(jpeg.begin(), jpeg.begin() + 40);
+    std::vector<uint8_t> no_soi(jpeg.begin() + 2, jpeg.end());
+
+    if (!check_rejected("dht with 200 one bit codes", with_dht(jpeg, one_bit)) ||
+        !check_rejected("dht with 3 two bit codes after a one bit code", with_dht(jpeg, two_bit)) ||
+        !check_rejected("dht with a three bit code after every two bit one", with_dht(jpeg, three_bit)) ||
+        !check_rejected("dht with 3 sixteen bit codes and room for 2", with_dht(jpeg, sixteen_bit)) ||
+        !check_rejected("truncated headers", headers_only) || !check_rejected("stream without soi", no_soi))
+        return 1;
+
+    // a scan cut short is decoded from zeros past its end, whatever comes out it stays within the buffers
+    for (size_t size = jpeg.size() / 2; size < jpeg.size(); size += jpeg.size() / 16)
+        decode(std::vector<uint8_t>(jpeg.begin(), jpeg.begin() + size), EL_PIXEL_FORMAT_RGB888, 1, nullptr);
+
+    std::printf("jpeg decoder checks passed\n");
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Hongtai Liu (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// Prints the CONFIG_EL_TFLITE_* defines the given models need, the union when several are given, ready to replace
+// the operator list of a port's el_config_porting.h. Built on the host against the same TensorFlow Lite Micro tree
+// and a port config (e.g. porting/posix with -DCONFIG_EL_TARGET_POSIX) together with core/engine/el_engine_tflite.cpp,
+// -DCONFIG_EL_ENGINE_MEMORY_PLAN_CACHE=0 keeps the storage backend out of the link.
+//
+//   tflite_ops_config detector.tflite classifier.tflite > el_tflite_ops.h
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "core/engine/el_engine_tflite.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s MODEL.tflite [MODEL.tflite ...]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> lines;
+    int                      status = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file) {
+            std::fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[i]);
+            return 1;
+        }
+        // flatbuffers are read in place, keep the copy aligned
+        std::string data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        std::vector<uint64_t> model((data.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        std::memcpy(model.data(), data.data(), data.size());
+
+        auto ret = edgelab::el_tflite_ops_config(
+          model.data(),
+          data.size(),
+          [](const char* line, void* user) {
+              auto* lines = static_cast<std::vector<std::string>*>(user);
+              for (const auto& l : *lines)
+                  if (l == line) return;
+              lines->emplace_back(line);
+          },
+          &lines);
+        if (ret == EL_EINVAL) {
+            std::fprintf(stderr, "%s: %s is not a tflite model\n", argv[0], argv[i]);
+            return 1;
+        }
+        if (ret != EL_OK) status = 1;
+    }
+
+    for (const auto& line : lines) std::printf("%s\n", line.c_str());
+
+    return status;
+}